@@ -11,41 +11,123 @@
 #ifndef AVL_H
 #define AVL_H
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "FrozenAVL.h"
+#include "NodePool.h"
+#include "Snapshot.h"
+#include "TreeStats.h"
+#include "WorkPool.h"
+
+/**
+ * @brief Comparador de três vias padrão da árvore. Retorna um valor negativo, zero ou positivo
+ * conforme a < b, a == b ou a > b. Usa o operador <=> quando o compilador e os tipos suportam;
+ * senão, monta o resultado com o operador <. Nesse caso (C++17, ou tipos sem <=>) uma chamada
+ * pode fazer duas comparações com <: a < b e, se for falso, b < a. Para tipos aritméticos as duas
+ * viram uma única instrução de comparação. É transparente, então aceita tipos diferentes nos
+ * dois lados (por exemplo std::string e std::string_view).
+ *
+ */
+struct three_way {
+    using is_transparent = void;
+
+    template <typename A, typename B>
+    int operator()(const A& a, const B& b) const {
+#if defined(__cpp_impl_three_way_comparison) && defined(__cpp_concepts)
+        if constexpr (requires { a <=> b; }) {
+            auto c = a <=> b;
+            return (c < 0) ? -1 : (c > 0);
+        }
+#endif
+        if constexpr (std::is_arithmetic_v<A> && std::is_arithmetic_v<B>) {
+            return (b < a) - (a < b);
+        }
+        return (a < b) ? -1 : (b < a);
+    }
+};
 
 /**
  * @brief Classe que representa uma árvore AVL
  *
  * @tparam T Tipo de dado a ser armazenado na árvore
+ * @tparam Compare Comparador de três vias: compare(a, b) retorna um valor comparável com 0
+ * (int ou std::*_ordering). Cada nível da descida faz uma única chamada; com o three_way sem
+ * <=> (C++17), essa chamada pode custar duas comparações com < (ver three_way).
+ * @tparam Stats Política de instrumentação (ver TreeStats.h). A padrão, NoStats, não gera código.
  */
-template <typename T>
+template <typename T, typename Compare = three_way, typename Stats = NoStats>
 class AVL_Tree {
    private:
     template <typename U>
     struct Node {
         U data{};       // dado armazenado no node
-        Node* left{};   // ponteiro para o filho esquerdo
-        Node* right{};  // ponteiro para o filho direito
-        int height{};   // altura do node
-
-        /**
-         * @brief Construtor do Node
-         *
-         * @param data Dado a ser armazenado no node
-         */
-        Node(const T& data) : data(data), height(1) {}
+        Node* left{};    // ponteiro para o filho esquerdo
+        Node* right{};   // ponteiro para o filho direito
+        Node* parent{};  // ponteiro para o pai
+        int height{};    // altura do node
+        int size{};      // quantidade de nodes na subarvore
 
         /**
-         * @brief Destrutor do Node
+         * @brief Construtor do Node. O dado é construído no próprio node a partir dos argumentos.
          *
+         * @param args Argumentos repassados ao construtor do dado
          */
-        ~Node() {
-            delete left;
-            delete right;
-        }
+        template <typename... Args>
+        explicit Node(Args&&... args) : data(std::forward<Args>(args)...), height(1), size(1) {}
     };
 
-    Node<T>* root{};  // raiz da arvore
+    static constexpr int MAX_HEIGHT = 96;         // altura maxima de uma AVL com ate 2^64 nodes
+    static constexpr int PARALLEL_GRAIN = 4096;  // tamanho minimo de lote para dividir entre threads
+    static constexpr int TASKS_PER_THREAD = 4;   // tarefas por thread do pool nas operacoes em lote
+    static constexpr int SMALL_SIDE_RATIO = 64;  // intersect remonta a arvore quando other e tao menor
+
+    Node<T>* root{};           // raiz da arvore
+    NodePool<Node<T>> pool{};  // blocos onde os nodes sao alocados
+    Compare compare{};         // comparador de tres vias das chaves
+    AVL_NO_UNIQUE_ADDRESS mutable Stats stats_{};  // contadores de instrumentacao
+
+    /**
+     * @brief Método privado que compara duas chaves com o comparador da árvore, contando a
+     * comparação na política de instrumentação
+     *
+     * @param a Primeira chave
+     * @param b Segunda chave
+     * @return Resultado de três vias de compare(a, b)
+     */
+    template <typename A, typename B>
+    auto cmp(const A& a, const B& b) const {
+        stats_.comparison();
+        return compare(a, b);
+    }
+
+    /**
+     * @brief Método privado que cria um node no pool, contando a alocação
+     *
+     * @param args Argumentos repassados ao construtor do dado
+     * @return Novo node
+     */
+    template <typename... Args>
+    Node<T>* _new_node(Args&&... args) {
+        Node<T>* node = pool.create(std::forward<Args>(args)...);
+        stats_.allocation();
+        return node;
+    }
+
+    /**
+     * @brief Método privado que destrói um node e devolve sua posição ao pool, contando a liberação
+     *
+     * @param node Node a ser destruído
+     */
+    void _delete_node(Node<T>* node) {
+        pool.destroy(node);
+        stats_.deallocation(1);
+    }
 
     /**
      * @brief Método privado que retorna a altura de um node
@@ -57,6 +139,16 @@ class AVL_Tree {
         return (node != nullptr) ? node->height : 0;
     }
 
+    /**
+     * @brief Método privado que retorna a quantidade de nodes da subárvore de um node
+     *
+     * @param node
+     * @return int
+     */
+    int size(Node<T>* node) const {
+        return (node != nullptr) ? node->size : 0;
+    }
+
     /**
      * @brief Método privado que retorna o fator de balanceamento de um node
      *
@@ -76,9 +168,16 @@ class AVL_Tree {
     Node<T>* rightRotation(Node<T>* p) {
         Node<T>* u = p->left;
         p->left = u->right;
+        if (p->left != nullptr) {
+            p->left->parent = p;
+        }
         u->right = p;
+        u->parent = p->parent;
+        p->parent = u;
         p->height = 1 + std::max(height(p->left), height(p->right));
         u->height = 1 + std::max(height(u->left), height(u->right));
+        p->size = 1 + size(p->left) + size(p->right);
+        u->size = 1 + size(u->left) + size(u->right);
         return u;
     }
 
@@ -91,324 +190,1777 @@ class AVL_Tree {
     Node<T>* leftRotation(Node<T>* p) {
         Node<T>* u = p->right;
         p->right = u->left;
+        if (p->right != nullptr) {
+            p->right->parent = p;
+        }
         u->left = p;
+        u->parent = p->parent;
+        p->parent = u;
         p->height = 1 + std::max(height(p->left), height(p->right));
         u->height = 1 + std::max(height(u->left), height(u->right));
+        p->size = 1 + size(p->left) + size(p->right);
+        u->size = 1 + size(u->left) + size(u->right);
         return u;
     }
 
     /**
-     * @brief Método privado que adiciona um elemento na árvore
+     * @brief Método privado que regula um node cujo fator de balanceamento pode ter saído de [-1, 1].
+     * A escolha da rotação usa apenas os fatores de balanceamento, servindo tanto para a inserção
+     * quanto para a remoção.
      *
-     * @param p Raiz da subárvore
-     * @param data Dado a ser adicionado
+     * @param node Node a ser regulado
      * @return Ponteiro para a nova raiz da subárvore
      */
-    Node<T>* _add(Node<T>* p, const T& data) {
-        if (p == nullptr) {  // subarvore vazia
-            return new Node<T>(data);
+    Node<T>* fixup(Node<T>* node) {
+        node->height = 1 + std::max(height(node->left), height(node->right));
+        int bal = balance(node);
+        if (bal < -1 && balance(node->left) <= 0) {
+            stats_.rotation(Rotation::LL);
+            return rightRotation(node);
+        } else if (bal < -1 && balance(node->left) > 0) {
+            stats_.rotation(Rotation::LR);
+            node->left = leftRotation(node->left);
+            return rightRotation(node);
+        } else if (bal > 1 && balance(node->right) >= 0) {
+            stats_.rotation(Rotation::RR);
+            return leftRotation(node);
+        } else if (bal > 1 && balance(node->right) < 0) {
+            stats_.rotation(Rotation::RL);
+            node->right = rightRotation(node->right);
+            return leftRotation(node);
         }
-        if (data == p->data) {  // chave ja existe
-            return p;
+        return node;
+    }
+
+    /**
+     * @brief Método privado que refaz o caminho de baixo para cima após uma inserção ou remoção,
+     * regulando cada node. A partir do primeiro node cuja subárvore manteve a altura nada mais
+     * precisa de rotação, e só o tamanho dos ancestrais é corrigido.
+     *
+     * @param path Ponteiros para os links (root, left ou right) de cada node do caminho
+     * @param depth Quantidade de links no caminho
+     * @param delta Variação do tamanho das subárvores do caminho (+1 ou -1)
+     */
+    void retrace(Node<T>** path[], int depth, int delta) {
+        while (depth > 0) {
+            Node<T>** link = path[--depth];
+            int old_height = (*link)->height;
+            (*link)->size += delta;
+            *link = fixup(*link);
+            if ((*link)->height == old_height) {
+                break;
+            }
         }
-        if (data < p->data) {
-            p->left = _add(p->left, data);
-        } else {
-            p->right = _add(p->right, data);
+        while (depth > 0) {
+            (*path[--depth])->size += delta;
         }
-        p = fixup_node(p, data);  // regula o node p
-        return p;
     }
 
     /**
-     * @brief Método privado que regula o node p após a adição de um novo elemento
+     * @brief Método privado que desce até o link onde data seria inserido, guardando o caminho
      *
-     * @param p Node a ser regulado
-     * @param data Dado adicionado
-     * @return Ponteiro para o node regulado
+     * @param data Dado a ser inserido
+     * @param path Saída: links de cada node do caminho
+     * @param depth Saída: quantidade de links no caminho
+     * @param parent Saída: node que será o pai do novo node
+     * @return Link vazio onde o novo node deve ficar, ou nullptr se data já está na árvore
      */
-    Node<T>* fixup_node(Node<T>* p, const T& data) {
-        p->height = 1 + std::max(height(p->left), height(p->right));
-        int bal = balance(p);
-        if (bal < -1 && data < p->left->data) {
-            return rightRotation(p);
-        } else if (bal < -1 && data > p->left->data) {
-            p->left = leftRotation(p->left);
-            return rightRotation(p);
-        } else if (bal > 1 && data > p->right->data) {
-            return leftRotation(p);
-        } else if (bal > 1 && data < p->right->data) {
-            p->right = rightRotation(p->right);
-            return leftRotation(p);
+    Node<T>** _find_link(const T& data, Node<T>** path[], int& depth, Node<T>*& parent) {
+        Node<T>** link = &root;
+        while (*link != nullptr) {
+            parent = *link;
+            auto c = cmp(data, parent->data);
+            if (c == 0) {  // chave ja existe
+                stats_.descent(depth + 1);
+                return nullptr;
+            }
+            path[depth++] = link;
+            link = (c < 0) ? &parent->left : &parent->right;
         }
-        return p;
+        stats_.descent(depth);
+        return link;
     }
 
     /**
-     * @brief Método privado que remove um elemento da árvore
+     * @brief Método privado que liga um novo node no link encontrado por _find_link e rebalanceia
      *
-     * @param node Node raiz da subárvore
-     * @param data Dado a ser removido
-     * @return Ponteiro para a nova raiz da subárvore
+     * @param link Link vazio onde o node vai ficar
+     * @param parent Pai do novo node
+     * @param node Novo node
+     * @param path Links do caminho até link
+     * @param depth Quantidade de links no caminho
      */
-    Node<T>* _remove(Node<T>* node, const T& data) {
-        if (node == nullptr) {  // node nao encontrado
-            return nullptr;
+    void _attach(Node<T>** link, Node<T>* parent, Node<T>* node, Node<T>** path[], int depth) {
+        *link = node;
+        node->parent = parent;
+        retrace(path, depth, +1);
+    }
+
+    /**
+     * @brief Método privado que adiciona um elemento, copiando ou movendo o dado conforme U
+     *
+     * @param data Dado a ser adicionado
+     * @return true se o elemento foi adicionado, false se já existia
+     */
+    template <typename U>
+    bool _add(U&& data) {
+        Node<T>** path[MAX_HEIGHT];
+        int depth = 0;
+        Node<T>* parent = nullptr;
+        Node<T>** link = _find_link(data, path, depth, parent);
+        if (link == nullptr) {
+            return false;
         }
-        if (data < node->data) {
-            node->left = _remove(node->left, data);
-        } else if (data > node->data) {
-            node->right = _remove(node->right, data);
-        } else if (node->right == nullptr) {
-            Node<T>* temp = node->left;
-            delete node;
-            return temp;
-        } else {
-            node->right = remove_sucessor(node, node->right);
+        _attach(link, parent, _new_node(std::forward<U>(data)), path, depth);
+        return true;
+    }
+
+    /**
+     * @brief Método privado que pendura um novo node como filho vazio de parent (ou como raiz, se
+     * parent é nullptr) e rebalanceia subindo pelos ponteiros para o pai. Não compara chaves.
+     *
+     * @param parent Pai do novo node
+     * @param left true para pendurar à esquerda, false à direita
+     * @param data Dado do novo node (copiado ou movido conforme U)
+     * @return O novo node
+     */
+    template <typename U>
+    Node<T>* _attach_leaf(Node<T>* parent, bool left, U&& data) {
+        Node<T>* node = _new_node(std::forward<U>(data));
+        node->parent = parent;
+        if (parent == nullptr) {
+            root = node;
+            return node;
+        }
+        (left ? parent->left : parent->right) = node;
+        bool rebalancing = true;
+        for (Node<T>* p = parent; p != nullptr; p = p->parent) {
+            p->size += 1;
+            if (rebalancing) {
+                Node<T>* up = p->parent;
+                Node<T>** link = (up == nullptr) ? &root : (up->left == p ? &up->left : &up->right);
+                int old_height = p->height;
+                p = *link = fixup(p);
+                rebalancing = p->height != old_height;
+            }
         }
-        node = fixup_deletion(node);
         return node;
     }
 
     /**
-     * @brief Método privado que remove o sucessor de um node
+     * @brief Método privado que implementa remove para qualquer tipo de chave comparável
      *
-     * @param root Node raiz da subárvore
-     * @param node Node a ser removido
-     * @return Ponteiro para a nova raiz da subárvore
+     * @param data Chave do elemento a ser removido
+     * @return true se o elemento foi removido, false se não estava na árvore
      */
-    Node<T>* remove_sucessor(Node<T>* root, Node<T>* node) {
-        if (node->left != nullptr) {
-            node->left = remove_sucessor(root, node->left);
+    template <typename K>
+    bool _remove(const K& data) {
+        Node<T>** path[MAX_HEIGHT];
+        int depth = 0;
+        Node<T>** link = &root;
+        while (*link != nullptr) {
+            auto c = cmp(data, (*link)->data);
+            if (c == 0) {
+                break;
+            }
+            path[depth++] = link;
+            link = (c < 0) ? &(*link)->left : &(*link)->right;
+        }
+        stats_.descent(depth + (*link != nullptr));
+        if (*link == nullptr) {  // node nao encontrado
+            return false;
+        }
+        Node<T>* node = *link;
+        if (node->right == nullptr) {
+            *link = node->left;
+            if (node->left != nullptr) {
+                node->left->parent = node->parent;
+            }
         } else {
-            Node<T>* temp = node->right;
-            root->data = node->data;
-            delete node;
-            return temp;
+            // o sucessor é religado no lugar do node, em vez de ter o valor movido, para que
+            // referências e iteradores para outras chaves continuem válidos
+            int at = depth;
+            path[depth++] = link;
+            Node<T>** succ = &node->right;
+            while ((*succ)->left != nullptr) {
+                path[depth++] = succ;
+                succ = &(*succ)->left;
+            }
+            Node<T>* s = *succ;
+            *succ = s->right;
+            if (s->right != nullptr) {
+                s->right->parent = s->parent;
+            }
+            s->left = node->left;
+            s->right = node->right;
+            s->parent = node->parent;
+            s->height = node->height;
+            s->size = node->size;
+            if (s->left != nullptr) {
+                s->left->parent = s;
+            }
+            if (s->right != nullptr) {
+                s->right->parent = s;
+            }
+            *link = s;
+            if (depth > at + 1) {
+                path[at + 1] = &s->right;  // era &node->right
+            }
         }
-        node = fixup_deletion(node);
-        return node;
+        _delete_node(node);
+        retrace(path, depth, -1);
+        return true;
     }
 
     /**
-     * @brief Método privado que regula o node após a remoção de um elemento
+     * @brief Método privado que copia uma subárvore com a mesma forma, sem comparar chaves nem
+     * rebalancear
      *
-     * @param node Node a ser regulado
-     * @return Ponteiro para o node regulado
+     * @param node Node raiz da subárvore a ser copiada
+     * @param parent Pai da cópia
+     * @return Raiz da cópia
      */
-    Node<T>* fixup_deletion(Node<T>* node) {
-        node->height = 1 + std::max(height(node->left), height(node->right));
-        int bal = balance(node);
-        if (bal < -1 && balance(node->left) <= 0) {
-            return rightRotation(node);
-        } else if (bal < -1 && balance(node->left) > 0) {
-            node->left = leftRotation(node->left);
-            return rightRotation(node);
-        } else if (bal > 1 && balance(node->right) >= 0) {
-            return leftRotation(node);
-        } else if (bal > 1 && balance(node->right) < 0) {
-            node->right = rightRotation(node->right);
-            return leftRotation(node);
+    Node<T>* _clone(const Node<T>* node, Node<T>* parent) {
+        if (node == nullptr) {
+            return nullptr;
         }
-        return node;
+        Node<T>* copy = _new_node(node->data);
+        copy->parent = parent;
+        copy->height = node->height;
+        copy->size = node->size;
+        copy->left = _clone(node->left, copy);
+        copy->right = _clone(node->right, copy);
+        return copy;
     }
 
     /**
-     * @brief Método privado que retorna uma string com a representação da árvore em pré-ordem
+     * @brief Método privado que recalcula altura e tamanho de um node a partir dos filhos e
+     * aponta os filhos para ele
      *
-     * @param node Node raiz da subárvore
-     * @return String com a representação da árvore em pré-ordem
+     * @param node Node a ser atualizado
      */
-    std::string _inOrder(Node<T>* node) {
-        std::string s = "";
-        if (node != nullptr) {
-            s += _inOrder(node->left);
-            s += std::to_string(node->data) + " ";
-            s += _inOrder(node->right);
+    void update(Node<T>* node) {
+        if (node->left != nullptr) {
+            node->left->parent = node;
         }
-        return s;
+        if (node->right != nullptr) {
+            node->right->parent = node;
+        }
+        node->height = 1 + std::max(height(node->left), height(node->right));
+        node->size = 1 + size(node->left) + size(node->right);
     }
 
     /**
-     * @brief Método privado que verifica se a árvore contém um dado
+     * @brief Método privado que une duas árvores AVL e um node do meio, sendo todas as chaves de
+     * l menores que a de m e todas as de r maiores. Desce pela lateral da árvore mais alta até
+     * encontrar uma subárvore com altura próxima à da outra, custando O(|h(l) - h(r)| + 1).
      *
-     * @param node Node raiz da subárvore
-     * @param data Dado a ser verificado
-     * @return true se contém,
-     * @return false caso contrário
+     * @param l Árvore com as chaves menores
+     * @param m Node do meio (solto)
+     * @param r Árvore com as chaves maiores
+     * @return Raiz da árvore unida
      */
-    Node<T>* _contains(Node<T>* node, const T& data) {
-        if (node == nullptr) {
-            return nullptr;
+    Node<T>* _join(Node<T>* l, Node<T>* m, Node<T>* r) {
+        if (height(l) > height(r) + 1) {
+            l->right = _join(l->right, m, r);
+            update(l);
+            return fixup(l);
         }
-        if (data == node->data) {
-            return node;
+        if (height(r) > height(l) + 1) {
+            r->left = _join(l, m, r->left);
+            update(r);
+            return fixup(r);
         }
-        if (data < node->data) {
-            return _contains(node->left, data);
+        m->left = l;
+        m->right = r;
+        update(m);
+        return m;
+    }
+
+    /**
+     * @brief Método privado que tira o maior node de uma árvore não vazia
+     *
+     * @param t Raiz da árvore
+     * @param last Saída: o maior node, solto
+     * @return Raiz da árvore sem o maior node
+     */
+    Node<T>* _split_last(Node<T>* t, Node<T>*& last) {
+        if (t->right == nullptr) {
+            last = t;
+            Node<T>* l = t->left;
+            t->left = nullptr;
+            update(t);
+            return l;
         }
-        return _contains(node->right, data);
+        t->right = _split_last(t->right, last);
+        update(t);
+        return fixup(t);
     }
 
     /**
-     * @brief Método privado que retorna o menor elemento da árvore
+     * @brief Método privado que une duas árvores AVL sem node do meio, usando o maior node de l
      *
-     * @param node Node raiz da subárvore
-     * @return Valor do menor elemento
+     * @param l Árvore com as chaves menores
+     * @param r Árvore com as chaves maiores
+     * @return Raiz da árvore unida
      */
-    T& _minimum(Node<T>* node) {
-        Node<T>* p = node;
-        while (p->left != nullptr) {
-            p = p->left;
+    Node<T>* _join2(Node<T>* l, Node<T>* r) {
+        if (l == nullptr) {
+            return r;
         }
-        return p->data;
+        Node<T>* last = nullptr;
+        Node<T>* rest = _split_last(l, last);
+        return _join(rest, last, r);
     }
 
     /**
-     * @brief Método privado que retorna o maior elemento da árvore
+     * @brief Método privado que divide uma árvore em chaves menores e maiores que key, em
+     * O(log n). O node com a chave, se existir, sai solto em mid.
      *
-     * @param node Node raiz da subárvore
-     * @return Valor do maior elemento
+     * @param t Raiz da árvore
+     * @param key Chave de divisão
+     * @param l Saída: árvore com as chaves menores
+     * @param mid Saída: node com a chave, ou nullptr
+     * @param r Saída: árvore com as chaves maiores
      */
-    T& _maximum(Node<T>* node) {
-        Node<T>* p = node;
-        while (p->right != nullptr) {
-            p = p->right;
+    void _split(Node<T>* t, const T& key, Node<T>*& l, Node<T>*& mid, Node<T>*& r) {
+        if (t == nullptr) {
+            l = mid = r = nullptr;
+            return;
+        }
+        Node<T>* tl = t->left;
+        Node<T>* tr = t->right;
+        t->left = t->right = nullptr;
+        auto c = cmp(key, t->data);
+        if (c == 0) {
+            l = tl;
+            r = tr;
+            mid = t;
+            update(t);
+        } else if (c < 0) {
+            Node<T>* rest = nullptr;
+            _split(tl, key, l, mid, rest);
+            r = _join(rest, t, tr);
+        } else {
+            Node<T>* rest = nullptr;
+            _split(tr, key, rest, mid, r);
+            l = _join(tl, t, rest);
         }
-        return p->data;
     }
 
-   public:
     /**
-     * @brief Construtor padrão da classe AVL_Tree
+     * @brief Método privado que executa f e g, em paralelo no WorkPool compartilhado se o orçamento
+     * permitir mais de uma tarefa. f deve usar tasks / 2 tarefas e g o resto, então as folhas da
+     * recursão somam no máximo tasks tarefas. Nenhuma thread é criada aqui: f fica na fila da
+     * thread atual e é roubada por uma thread ociosa do pool, ou executada pela própria thread.
      *
+     * @param tasks Tarefas disponíveis para f e g
+     * @param f Primeira tarefa (pode ser roubada por outra thread)
+     * @param g Segunda tarefa (roda na thread atual)
      */
-    AVL_Tree() = default;
+    template <typename F, typename G>
+    static void _fork_join(int tasks, F f, G g) {
+        if (tasks > 1) {
+            WorkPool::shared().fork_join(f, g);
+        } else {
+            f();
+            g();
+        }
+    }
 
     /**
-     * @brief Metodo para adicionar um elemento na arvore
+     * @brief Método privado que retorna em quantas tarefas dividir uma operação em lote:
+     * TASKS_PER_THREAD por thread do WorkPool, para que o roubo de tarefas equilibre metades de
+     * tamanhos diferentes, ou 1 se o pool não tem threads (um núcleo só)
      *
-     * @param data
+     * @return Orçamento de tarefas
      */
-    void add(const T& data) {
-        root = _add(root, data);
+    static int _parallel_tasks() {
+        int threads = WorkPool::shared().concurrency();
+        return (threads > 1) ? TASKS_PER_THREAD * threads : 1;
     }
 
     /**
-     * @brief Metodo para remover um elemento da arvore
+     * @brief Método privado que liga nodes já criados, em ordem, como uma árvore balanceada
      *
-     * @param data
+     * @param nodes Nodes em ordem crescente
+     * @param n Quantidade de nodes
+     * @return Raiz da árvore
      */
-    void remove(const T& data) {
-        root = _remove(root, data);
+    Node<T>* _link_sorted(Node<T>** nodes, int n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        int left_size = n / 2;
+        Node<T>* node = nodes[left_size];
+        node->left = _link_sorted(nodes, left_size);
+        node->right = _link_sorted(nodes + left_size + 1, n - left_size - 1);
+        update(node);
+        return node;
     }
 
     /**
-     * @brief Método que remove todos os elementos da árvore.
+     * @brief Método privado que insere um lote ordenado de nodes em uma subárvore: divide a árvore
+     * pela chave do meio do lote, resolve as duas metades (em paralelo, se tasks > 1) e junta de
+     * volta. Nodes do lote cuja chave já existia ficam marcados em dup para serem devolvidos.
      *
+     * @param t Raiz da subárvore
+     * @param nodes Nodes do lote, em ordem crescente e sem repetições
+     * @param n Quantidade de nodes do lote
+     * @param dup Saída: dup[i] = 1 se nodes[i] não foi usado
+     * @param tasks Tarefas disponíveis para esta subárvore
+     * @return Raiz da subárvore resultante
      */
-    void clear() {
-        delete root;
-        root = nullptr;
+    Node<T>* _union(Node<T>* t, Node<T>** nodes, int n, char* dup, int tasks) {
+        if (n == 0) {
+            return t;
+        }
+        if (t == nullptr) {
+            return _link_sorted(nodes, n);
+        }
+        int mid = n / 2;
+        Node<T>* l = nullptr;
+        Node<T>* found = nullptr;
+        Node<T>* r = nullptr;
+        _split(t, nodes[mid]->data, l, found, r);
+        int here = (n >= PARALLEL_GRAIN) ? tasks : 1;
+        _fork_join(
+            here, [&] { l = _union(l, nodes, mid, dup, here / 2); },
+            [&] { r = _union(r, nodes + mid + 1, n - mid - 1, dup + mid + 1, here - here / 2); });
+        if (found != nullptr) {
+            dup[mid] = 1;
+        } else {
+            found = nodes[mid];
+        }
+        return _join(l, found, r);
     }
 
     /**
-     * @brief Método que troca o conteúdo de duas árvores AVL. Apenas troca os ponteiros para as raízes.
+     * @brief Método privado que remove um lote ordenado de chaves de uma subárvore, dividindo e
+     * juntando como em _union. Os nodes removidos são guardados em removed para serem devolvidos.
      *
-     * @param other Árvore AVL a ser trocada
+     * @param t Raiz da subárvore
+     * @param keys Chaves do lote, em ordem crescente e sem repetições
+     * @param n Quantidade de chaves do lote
+     * @param removed Saída: removed[i] = node da chave keys[i], ou nullptr
+     * @param tasks Tarefas disponíveis para esta subárvore
+     * @return Raiz da subárvore resultante
      */
-    void swap(AVL_Tree<T>& other) {
-        std::swap(root, other.root);
+    Node<T>* _difference(Node<T>* t, const T* keys, int n, Node<T>** removed, int tasks) {
+        if (n == 0 || t == nullptr) {
+            return t;
+        }
+        int mid = n / 2;
+        Node<T>* l = nullptr;
+        Node<T>* r = nullptr;
+        _split(t, keys[mid], l, removed[mid], r);
+        int here = (n >= PARALLEL_GRAIN) ? tasks : 1;
+        _fork_join(
+            here, [&] { l = _difference(l, keys, mid, removed, here / 2); },
+            [&] {
+                r = _difference(r, keys + mid + 1, n - mid - 1, removed + mid + 1, here - here / 2);
+            });
+        return _join2(l, r);
     }
 
     /**
-     * @brief Método que retorna o menor elemento da árvore
+     * @brief Método privado que guarda todos os nodes de uma subárvore em out
      *
-     * @return Valor do menor elemento
+     * @param t Raiz da subárvore
+     * @param out Saída: nodes da subárvore
      */
-    T& minimum() {
-        return _minimum(root);
+    static void _collect(Node<T>* t, std::vector<Node<T>*>& out) {
+        if (t != nullptr) {
+            _collect(t->left, out);
+            out.push_back(t);
+            _collect(t->right, out);
+        }
     }
 
     /**
-     * @brief Método que retorna o maior elemento da árvore
-     *s
-     * @return Valor do maior elemento
+     * @brief Método privado que une duas árvores: divide b pela chave da raiz de a, une as
+     * metades com as subárvores de a (em paralelo, se tasks > 1) e junta de volta com a raiz de a.
+     * A recursão para quando um dos lados fica vazio, então o custo é O(m log(n/m + 1)) para
+     * m = min(|a|, |b|). Os nodes de b com chave repetida são guardados em dups.
+     *
+     * @param a Raiz da primeira árvore
+     * @param b Raiz da segunda árvore
+     * @param dups Saída: nodes de b que não foram usados
+     * @param tasks Tarefas disponíveis para esta subárvore
+     * @return Raiz da árvore unida
      */
-    T& maximum() {
-        return _maximum(root);
+    Node<T>* _unite(Node<T>* a, Node<T>* b, std::vector<Node<T>*>& dups, int tasks) {
+        if (a == nullptr) {
+            return b;
+        }
+        if (b == nullptr) {
+            return a;
+        }
+        int here = (size(a) + size(b) >= PARALLEL_GRAIN) ? tasks : 1;
+        Node<T>* l = nullptr;
+        Node<T>* found = nullptr;
+        Node<T>* r = nullptr;
+        _split(b, a->data, l, found, r);
+        if (found != nullptr) {
+            dups.push_back(found);
+        }
+        Node<T>* al = a->left;
+        Node<T>* ar = a->right;
+        a->left = a->right = nullptr;
+        std::vector<Node<T>*> right_dups;
+        std::vector<Node<T>*>& rd = (here > 1) ? right_dups : dups;
+        _fork_join(
+            here, [&] { l = _unite(al, l, dups, here / 2); },
+            [&] { r = _unite(ar, r, rd, here - here / 2); });
+        dups.insert(dups.end(), right_dups.begin(), right_dups.end());
+        return _join(l, a, r);
     }
 
     /**
-     * @brief Método que retorna o sucessor de um elemento
+     * @brief Método privado que mantém em t só as chaves que também estão em other: divide t pela
+     * chave da raiz de other e resolve as metades com as subárvores de other. other só é lida.
      *
-     * @param key Elemento a ser verificado
-     * @return Sucessor do elemento
+     * @param t Raiz da árvore alterada
+     * @param other Raiz da árvore consultada
+     * @param dropped Saída: nodes de t que saíram
+     * @param tasks Tarefas disponíveis para esta subárvore
+     * @return Raiz da interseção
      */
-    T& successor(const T& key) {
-        if (!contains(key)) {
-            throw std::runtime_error("Elemento não está no conjunto");
+    Node<T>* _intersect(Node<T>* t, Node<T>* other, std::vector<Node<T>*>& dropped, int tasks) {
+        if (t == nullptr) {
+            return nullptr;
         }
-        Node<T>* p = root;
-        Node<T>* sucessor = nullptr;
-        while (p != nullptr) {
-            if (p->data > key) {
-                sucessor = p;
-                p = p->left;
-            } else {
-                p = p->right;
-            }
+        if (other == nullptr) {
+            _collect(t, dropped);
+            return nullptr;
         }
-        if (sucessor == nullptr) {
-            throw std::runtime_error("Não existe sucessor");
+        int here = (size(t) + size(other) >= PARALLEL_GRAIN) ? tasks : 1;
+        Node<T>* l = nullptr;
+        Node<T>* found = nullptr;
+        Node<T>* r = nullptr;
+        _split(t, other->data, l, found, r);
+        std::vector<Node<T>*> right_dropped;
+        std::vector<Node<T>*>& rd = (here > 1) ? right_dropped : dropped;
+        _fork_join(
+            here, [&] { l = _intersect(l, other->left, dropped, here / 2); },
+            [&] { r = _intersect(r, other->right, rd, here - here / 2); });
+        dropped.insert(dropped.end(), right_dropped.begin(), right_dropped.end());
+        return (found != nullptr) ? _join(l, found, r) : _join2(l, r);
+    }
+
+    /**
+     * @brief Método privado que tira de t as chaves que estão em other, dividindo t pela chave da
+     * raiz de other como em _intersect. A recursão para quando um dos lados fica vazio.
+     *
+     * @param t Raiz da árvore alterada
+     * @param other Raiz da árvore consultada
+     * @param dropped Saída: nodes de t que saíram
+     * @param tasks Tarefas disponíveis para esta subárvore
+     * @return Raiz da diferença
+     */
+    Node<T>* _subtract(Node<T>* t, Node<T>* other, std::vector<Node<T>*>& dropped, int tasks) {
+        if (t == nullptr || other == nullptr) {
+            return t;
         }
-        return sucessor->data;
+        int here = (size(t) + size(other) >= PARALLEL_GRAIN) ? tasks : 1;
+        Node<T>* l = nullptr;
+        Node<T>* found = nullptr;
+        Node<T>* r = nullptr;
+        _split(t, other->data, l, found, r);
+        if (found != nullptr) {
+            dropped.push_back(found);
+        }
+        std::vector<Node<T>*> right_dropped;
+        std::vector<Node<T>*>& rd = (here > 1) ? right_dropped : dropped;
+        _fork_join(
+            here, [&] { l = _subtract(l, other->left, dropped, here / 2); },
+            [&] { r = _subtract(r, other->right, rd, here - here / 2); });
+        dropped.insert(dropped.end(), right_dropped.begin(), right_dropped.end());
+        return _join2(l, r);
     }
 
     /**
-     * @brief Método que retorna o antecessor de um elemento
+     * @brief Método privado que devolve ao pool os nodes que saíram da árvore
      *
-     * @param key Elemento a ser verificado
-     * @return Antecessor do elemento
+     * @param nodes Nodes soltos
      */
-    T& predecessor(const T& key) {
-        if (!contains(key)) {
-            throw std::runtime_error("Elemento não está no conjunto");
+    void _delete_nodes(std::vector<Node<T>*>& nodes) {
+        for (Node<T>* node : nodes) {
+            _delete_node(node);
         }
+    }
+
+    /**
+     * @brief Método privado que copia uma sequência para um vetor ordenado e sem repetições
+     *
+     * @param first Início da sequência
+     * @param last Fim da sequência
+     * @return Vetor ordenado
+     */
+    template <typename It>
+    std::vector<T> _sorted_unique(It first, It last) {
+        std::vector<T> keys(first, last);
+        std::sort(keys.begin(), keys.end(), [this](const T& a, const T& b) { return compare(a, b) < 0; });
+        auto same = [this](const T& a, const T& b) { return compare(a, b) == 0; };
+        keys.erase(std::unique(keys.begin(), keys.end(), same), keys.end());
+        return keys;
+    }
+
+    /**
+     * @brief Método privado que conta os elementos menores que key (ou menores ou iguais, se
+     * inclusive for true)
+     *
+     * @param key Chave de referência
+     * @param inclusive Se true, conta também o elemento igual a key
+     * @return Quantidade de elementos
+     */
+    int _count_less(const T& key, bool inclusive) const {
+        int count = 0;
+        int levels = 0;
         Node<T>* p = root;
-        Node<T>* pred = nullptr;
         while (p != nullptr) {
-            if (p->data < key) {
-                pred = p;
+            levels++;
+            auto c = cmp(p->data, key);
+            if (c < 0 || (inclusive && c == 0)) {
+                count += size(p->left) + 1;
                 p = p->right;
             } else {
                 p = p->left;
             }
         }
-        if (pred == nullptr) {
-            throw std::runtime_error("Não existe antecessor");
+        stats_.descent(levels);
+        return count;
+    }
+
+    /**
+     * @brief Método privado que constrói uma subárvore perfeitamente balanceada com os próximos n
+     * elementos de uma sequência ordenada e sem repetições. Os elementos são consumidos em ordem,
+     * então basta um iterador de passagem única.
+     *
+     * @param it Iterador para o próximo elemento da sequência
+     * @param n Quantidade de elementos da subárvore
+     * @return Ponteiro para a raiz da subárvore
+     */
+    template <typename It>
+    Node<T>* _build(It& it, int n) {
+        if (n == 0) {
+            return nullptr;
         }
-        return pred->data;
+        int left_size = n / 2;
+        Node<T>* left = _build(it, left_size);
+        Node<T>* node = _new_node(*it);
+        ++it;
+        node->left = left;
+        node->right = _build(it, n - left_size - 1);
+        if (node->left != nullptr) {
+            node->left->parent = node;
+        }
+        if (node->right != nullptr) {
+            node->right->parent = node;
+        }
+        node->height = 1 + std::max(height(node->left), height(node->right));
+        node->size = n;
+        return node;
     }
 
     /**
-     * @brief Método que retorna uma string com a representação da árvore em pré-ordem
+     * @brief Método privado que visita os elementos de uma subárvore que estão em [lo, hi],
+     * descendo apenas pelos lados que podem conter elementos do intervalo
      *
-     * @return String com a representação da árvore em pré-ordem
+     * @param node Node raiz da subárvore
+     * @param lo Limite inferior
+     * @param hi Limite superior
+     * @param visit Função chamada com cada elemento do intervalo
      */
-    std::string inOrder() {
-        return _inOrder(root);
+    template <typename Visitor>
+    void _for_each_in_range(Node<T>* node, const T& lo, const T& hi, Visitor& visit) const {
+        if (node == nullptr) {
+            return;
+        }
+        auto c_lo = cmp(lo, node->data);
+        auto c_hi = cmp(node->data, hi);
+        if (c_lo < 0) {
+            _for_each_in_range(node->left, lo, hi, visit);
+        }
+        if (c_lo <= 0 && c_hi <= 0) {
+            visit(node->data);
+        }
+        if (c_hi < 0) {
+            _for_each_in_range(node->right, lo, hi, visit);
+        }
     }
 
     /**
-     * @brief Função pública que verifica se a árvore contém a chave val
+     * @brief Método privado que destrói todos os nodes de uma subárvore
+     *
+     * @param node Node raiz da subárvore
+     */
+    void _destroy(Node<T>* node) {
+        if (node != nullptr) {
+            _destroy(node->left);
+            _destroy(node->right);
+            pool.destroy(node);
+        }
+    }
+
+    /**
+     * @brief Método privado que retorna uma string com a representação da árvore em pré-ordem
+     *
+     * @param node Node raiz da subárvore
+     * @return String com a representação da árvore em pré-ordem
+     */
+    std::string _inOrder(Node<T>* node) {
+        std::string s = "";
+        if (node != nullptr) {
+            s += _inOrder(node->left);
+            s += std::to_string(node->data) + " ";
+            s += _inOrder(node->right);
+        }
+        return s;
+    }
+
+    /**
+     * @brief Método privado que procura o node com a chave key, com uma comparação por nível.
+     * Para chaves aritméticas com o three_way, usa == e < direto: o compilador desce com uma única
+     * instrução de comparação por nível, enquanto montar o resultado de três vias deixa a busca
+     * cerca de 2,5 vezes mais lenta (ver bench/iterative_vs_recursive.cpp).
+     *
+     * @param key Chave a ser procurada (T ou tipo aceito por um comparador transparente)
+     * @return Node com a chave, ou nullptr se não existir
+     */
+    template <typename K>
+    Node<T>* _find(const K& key) const {
+        int levels = 0;
+        Node<T>* node = root;
+        if constexpr (std::is_same_v<Compare, three_way> && std::is_arithmetic_v<T> &&
+                      std::is_arithmetic_v<K>) {
+            while (node != nullptr) {
+                levels++;
+                stats_.comparison();
+                if (key == node->data) {
+                    break;
+                }
+                node = (key < node->data) ? node->left : node->right;
+            }
+        } else {
+            while (node != nullptr) {
+                levels++;
+                auto c = cmp(key, node->data);
+                if (c == 0) {
+                    break;
+                }
+                node = (c < 0) ? node->left : node->right;
+            }
+        }
+        stats_.descent(levels);
+        return node;
+    }
+
+    /**
+     * @brief Método privado que retorna o primeiro node com chave maior ou igual a key
+     *
+     * @param key Chave de referência
+     * @return Node encontrado, ou nullptr
+     */
+    template <typename K>
+    Node<T>* _lower_bound(const K& key) const {
+        int levels = 0;
+        Node<T>* p = root;
+        Node<T>* bound = nullptr;
+        while (p != nullptr) {
+            levels++;
+            if (cmp(p->data, key) < 0) {
+                p = p->right;
+            } else {
+                bound = p;
+                p = p->left;
+            }
+        }
+        stats_.descent(levels);
+        return bound;
+    }
+
+    /**
+     * @brief Método privado que retorna o primeiro node com chave maior que key
+     *
+     * @param key Chave de referência
+     * @return Node encontrado, ou nullptr
+     */
+    template <typename K>
+    Node<T>* _upper_bound(const K& key) const {
+        int levels = 0;
+        Node<T>* p = root;
+        Node<T>* bound = nullptr;
+        while (p != nullptr) {
+            levels++;
+            if (cmp(key, p->data) < 0) {
+                bound = p;
+                p = p->left;
+            } else {
+                p = p->right;
+            }
+        }
+        stats_.descent(levels);
+        return bound;
+    }
+
+    /**
+     * @brief Método privado que faz a descida de equal_range: encontra o node com a chave ou,
+     * se ela não existir, o primeiro node maior que ela
+     *
+     * @param key Chave de referência
+     * @return Par (node, true se o node tem a chave)
+     */
+    template <typename K>
+    std::pair<Node<T>*, bool> _equal_range(const K& key) const {
+        int levels = 0;
+        Node<T>* p = root;
+        Node<T>* bound = nullptr;
+        while (p != nullptr) {
+            levels++;
+            auto c = cmp(key, p->data);
+            if (c > 0) {
+                p = p->right;
+            } else if (c < 0) {
+                bound = p;
+                p = p->left;
+            } else {
+                stats_.descent(levels);
+                return {p, true};
+            }
+        }
+        stats_.descent(levels);
+        return {bound, false};
+    }
+
+    /**
+     * @brief Método privado que retorna o menor elemento da árvore
+     *
+     * @param node Node raiz da subárvore
+     * @return Valor do menor elemento
+     */
+    T& _minimum(Node<T>* node) {
+        Node<T>* p = node;
+        while (p->left != nullptr) {
+            p = p->left;
+        }
+        return p->data;
+    }
+
+    /**
+     * @brief Método privado que retorna o maior elemento da árvore
+     *
+     * @param node Node raiz da subárvore
+     * @return Valor do maior elemento
+     */
+    T& _maximum(Node<T>* node) {
+        Node<T>* p = node;
+        while (p->right != nullptr) {
+            p = p->right;
+        }
+        return p->data;
+    }
+
+   public:
+    /**
+     * @brief Iterador bidirecional que percorre a árvore em ordem crescente usando os ponteiros
+     * para o pai. Não aloca memória. Os elementos são somente leitura, pois alterar uma chave
+     * quebraria a ordem da árvore.
+     *
+     */
+    class iterator {
+       private:
+        Node<T>* node{};         // node atual (nullptr representa o fim)
+        const AVL_Tree* tree{};  // árvore percorrida, usada para voltar a partir do fim
+
+        friend class AVL_Tree;
+
+        iterator(Node<T>* node, const AVL_Tree* tree) : node(node), tree(tree) {}
+
+       public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        iterator() = default;
+
+        reference operator*() const {
+            return node->data;
+        }
+
+        pointer operator->() const {
+            return &node->data;
+        }
+
+        /**
+         * @brief Avança para o sucessor: o menor da subárvore direita ou o primeiro ancestral do
+         * qual o node está à esquerda
+         *
+         */
+        iterator& operator++() {
+            if (node->right != nullptr) {
+                node = node->right;
+                while (node->left != nullptr) {
+                    node = node->left;
+                }
+            } else {
+                Node<T>* p = node->parent;
+                while (p != nullptr && node == p->right) {
+                    node = p;
+                    p = p->parent;
+                }
+                node = p;
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        /**
+         * @brief Volta para o antecessor. A partir do fim, vai para o maior elemento.
+         *
+         */
+        iterator& operator--() {
+            if (node == nullptr) {
+                node = tree->root;
+                while (node->right != nullptr) {
+                    node = node->right;
+                }
+            } else if (node->left != nullptr) {
+                node = node->left;
+                while (node->right != nullptr) {
+                    node = node->right;
+                }
+            } else {
+                Node<T>* p = node->parent;
+                while (p != nullptr && node == p->left) {
+                    node = p;
+                    p = p->parent;
+                }
+                node = p;
+            }
+            return *this;
+        }
+
+        iterator operator--(int) {
+            iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const iterator& other) const {
+            return node == other.node;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return node != other.node;
+        }
+    };
+
+    using const_iterator = iterator;
+
+   private:
+    /**
+     * @brief Método privado que implementa add_hint, copiando ou movendo o dado conforme U
+     *
+     * @param h Node sugerido (nullptr para o fim)
+     * @param data Dado a ser adicionado
+     * @return Node com a chave data
+     */
+    template <typename U>
+    Node<T>* _add_hint(Node<T>* h, U&& data) {
+        if (root == nullptr) {
+            return _attach_leaf(nullptr, false, std::forward<U>(data));
+        }
+        if (h == nullptr) {  // fim: data deve ser maior que o maximo
+            Node<T>* max = root;
+            while (max->right != nullptr) {
+                max = max->right;
+            }
+            if (cmp(max->data, data) < 0) {
+                return _attach_leaf(max, false, std::forward<U>(data));
+            }
+        } else {
+            auto c = cmp(data, h->data);
+            if (c == 0) {
+                return h;
+            }
+            if (c < 0) {
+                iterator before(h, this);
+                if (before == begin()) {
+                    return _attach_leaf(h, true, std::forward<U>(data));
+                }
+                --before;
+                if (cmp(before.node->data, data) < 0) {
+                    if (before.node->right == nullptr) {
+                        return _attach_leaf(before.node, false, std::forward<U>(data));
+                    }
+                    return _attach_leaf(h, true, std::forward<U>(data));
+                }
+            } else {
+                iterator after = std::next(iterator(h, this));
+                if (after == end() || cmp(data, after.node->data) < 0) {
+                    if (h->right == nullptr) {
+                        return _attach_leaf(h, false, std::forward<U>(data));
+                    }
+                    return _attach_leaf(after.node, true, std::forward<U>(data));
+                }
+            }
+        }
+        Node<T>** path[MAX_HEIGHT];
+        int depth = 0;
+        Node<T>* parent = nullptr;
+        Node<T>** link = _find_link(data, path, depth, parent);
+        if (link == nullptr) {  // parent é o node que já tem a chave
+            return parent;
+        }
+        Node<T>* node = _new_node(std::forward<U>(data));
+        _attach(link, parent, node, path, depth);
+        return node;
+    }
+
+   public:
+
+    /**
+     * @brief Construtor padrão da classe AVL_Tree
+     *
+     */
+    AVL_Tree() = default;
+
+    /**
+     * @brief Construtor de cópia. Copia a estrutura da outra árvore em O(n), sem rebalancear.
+     *
+     * @param other Árvore a ser copiada
+     */
+    AVL_Tree(const AVL_Tree& other) : compare(other.compare) {
+        pool.reserve(other.root != nullptr ? other.root->size : 0);
+        root = _clone(other.root, nullptr);
+    }
+
+    /**
+     * @brief Atribuição por cópia
+     *
+     * @param other Árvore a ser copiada
+     * @return Referência para esta árvore
+     */
+    AVL_Tree& operator=(const AVL_Tree& other) {
+        if (this != &other) {
+            AVL_Tree copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Construtor de movimento. A árvore de origem fica vazia.
+     *
+     * @param other Árvore a ser movida
+     */
+    AVL_Tree(AVL_Tree&& other) noexcept {
+        swap(other);
+    }
+
+    /**
+     * @brief Atribuição por movimento. Os elementos atuais são liberados.
+     *
+     * @param other Árvore a ser movida
+     * @return Referência para esta árvore
+     */
+    AVL_Tree& operator=(AVL_Tree&& other) noexcept {
+        if (this != &other) {
+            clear();
+            swap(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destrutor da classe AVL_Tree. Libera todos os blocos de nodes.
+     *
+     */
+    ~AVL_Tree() {
+        clear();
+    }
+
+    /**
+     * @brief Cria uma árvore a partir de uma sequência em tempo linear, com uma única alocação de
+     * nodes. Se a sequência não estiver em ordem estritamente crescente, ela é copiada, ordenada e
+     * tem as repetições removidas antes da construção.
+     *
+     * @param first Início da sequência
+     * @param last Fim da sequência
+     * @return Árvore com os elementos da sequência
+     */
+    template <typename It>
+    static AVL_Tree from_sorted(It first, It last) {
+        AVL_Tree tree;
+        auto not_increasing = [&tree](const T& a, const T& b) { return tree.compare(a, b) >= 0; };
+        if (std::adjacent_find(first, last, not_increasing) == last) {
+            int n = static_cast<int>(std::distance(first, last));
+            tree.pool.reserve(n);
+            tree.root = tree._build(first, n);
+        } else {
+            std::vector<T> keys = tree._sorted_unique(first, last);
+            auto it = keys.begin();
+            tree.pool.reserve(keys.size());
+            tree.root = tree._build(it, static_cast<int>(keys.size()));
+        }
+        return tree;
+    }
+
+    /**
+     * @brief Metodo que congela a árvore em um vetor imutável em layout de Eytzinger, próprio
+     * para conjuntos que só recebem consultas depois de montados (ver FrozenAVL.h)
+     *
+     * @return Cópia congelada dos elementos
+     */
+    Frozen_AVL_Tree<T, Compare> freeze() const {
+        return Frozen_AVL_Tree<T, Compare>(begin(), size(), compare);
+    }
+
+    /**
+     * @brief Metodo que descongela um vetor de Eytzinger de volta em uma árvore mutável, em
+     * tempo linear
+     *
+     * @param frozen Conjunto congelado
+     * @return Árvore com os mesmos elementos
+     */
+    static AVL_Tree thaw(const Frozen_AVL_Tree<T, Compare>& frozen) {
+        AVL_Tree tree;
+        auto it = frozen.begin();
+        tree.pool.reserve(frozen.size());
+        tree.root = tree._build(it, static_cast<int>(frozen.size()));
+        return tree;
+    }
+
+    /**
+     * @brief Metodo que grava a árvore em um snapshot binário (ver Snapshot.h). Só existe para
+     * chaves inteiras.
+     *
+     * @param path Caminho do arquivo
+     */
+    void save(const std::string& path) const {
+        Snapshot::write<T>(path, begin(), end(), root != nullptr ? root->size : 0);
+    }
+
+    /**
+     * @brief Metodo que carrega uma árvore de um snapshot binário. O arquivo é mapeado e as
+     * chaves são decodificadas direto para a construção balanceada, em tempo linear.
+     *
+     * @param path Caminho do arquivo
+     * @return Árvore com as chaves do snapshot
+     */
+    static AVL_Tree load(const std::string& path) {
+        static_assert(std::is_integral<T>::value, "Snapshot só suporta chaves inteiras");
+        Snapshot::File file(path);
+        std::uint64_t n = file.count();
+        if (n > static_cast<std::uint64_t>(file.end() - file.begin())) {
+            throw std::runtime_error("Snapshot corrompido");
+        }
+        AVL_Tree tree;
+        Snapshot::Reader<T> reader(file.begin(), file.end());
+        tree.pool.reserve(n);
+        tree.root = tree._build(reader, static_cast<int>(n));
+        auto not_increasing = [&tree](const T& a, const T& b) { return tree.compare(a, b) >= 0; };
+        if (!reader.consumed(n) || std::adjacent_find(tree.begin(), tree.end(), not_increasing) != tree.end()) {
+            throw std::runtime_error("Snapshot corrompido");
+        }
+        return tree;
+    }
+
+    /**
+     * @brief Metodo para adicionar um elemento na arvore. A descida é iterativa e guarda o caminho
+     * em uma pilha de tamanho fixo, usada depois para rebalancear.
+     *
+     * @param data
+     * @return true se o elemento foi adicionado, false se já existia
+     */
+    bool add(const T& data) {
+        return _add(data);
+    }
+
+    /**
+     * @brief Metodo para adicionar um elemento na arvore, movendo o dado para o node
+     *
+     * @param data
+     * @return true se o elemento foi adicionado, false se já existia
+     */
+    bool add(T&& data) {
+        return _add(std::move(data));
+    }
+
+    /**
+     * @brief Metodo para adicionar um elemento usando uma dica de posição: hint deve apontar para
+     * um vizinho de data na ordem, isto é, o elemento logo antes ou logo depois dele (end() para
+     * chaves maiores que todas). Com uma dica correta a inserção faz no máximo duas comparações,
+     * então chaves crescentes inseridas com add_hint(end(), key), ou chaves agrupadas inseridas
+     * com a dica devolvida pela inserção anterior, custam O(1) comparações. Com uma dica errada,
+     * cai na inserção comum.
+     *
+     * @param hint Posição sugerida
+     * @param data
+     * @return Iterador para o elemento com a chave data (inserido agora ou já existente)
+     */
+    iterator add_hint(iterator hint, const T& data) {
+        return iterator(_add_hint(hint.node, data), this);
+    }
+
+    /**
+     * @brief Versão de add_hint que move o dado para o node
+     *
+     * @param hint Posição sugerida
+     * @param data
+     * @return Iterador para o elemento com a chave data (inserido agora ou já existente)
+     */
+    iterator add_hint(iterator hint, T&& data) {
+        return iterator(_add_hint(hint.node, std::move(data)), this);
+    }
+
+    /**
+     * @brief Metodo que constrói o elemento diretamente no node a partir dos argumentos. Se a
+     * chave já existir, o node construído é descartado.
+     *
+     * @param args Argumentos repassados ao construtor de T
+     * @return true se o elemento foi adicionado, false se já existia
+     */
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        Node<T>** path[MAX_HEIGHT];
+        int depth = 0;
+        Node<T>* parent = nullptr;
+        Node<T>* node = _new_node(std::forward<Args>(args)...);
+        Node<T>** link = _find_link(node->data, path, depth, parent);
+        if (link == nullptr) {
+            _delete_node(node);
+            return false;
+        }
+        _attach(link, parent, node, path, depth);
+        return true;
+    }
+
+    /**
+     * @brief Metodo para remover um elemento da arvore. Se o node tem filho direito, o node do
+     * sucessor é religado no lugar dele; nenhum dado é movido, então referências e iteradores
+     * para os outros elementos continuam válidos.
+     *
+     * @param data
+     * @return true se o elemento foi removido, false se não estava na árvore
+     */
+    bool remove(const T& data) {
+        return _remove(data);
+    }
+
+    /**
+     * @brief Versão de remove para chaves de outro tipo, disponível com comparador transparente
+     *
+     * @param key Chave do elemento a ser removido
+     * @return true se o elemento foi removido, false se não estava na árvore
+     */
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    bool remove(const K& key) {
+        return _remove(key);
+    }
+
+    /**
+     * @brief Metodo que adiciona um lote de elementos. O lote é ordenado e a árvore é dividida
+     * pela chave do meio do lote; as duas metades são processadas recursivamente em paralelo e
+     * juntadas de volta, com custo O(m log(n/m + 1)) para m elementos no lote. Os nodes são
+     * alocados antes da fase paralela, então o pool só é usado por esta thread.
+     *
+     * @param first Início do lote
+     * @param last Fim do lote
+     * @return Quantidade de elementos efetivamente adicionados
+     */
+    template <typename It>
+    int insert_batch(It first, It last) {
+        std::vector<T> keys = _sorted_unique(first, last);
+        int n = static_cast<int>(keys.size());
+        std::vector<Node<T>*> nodes(n);
+        pool.reserve(n);
+        for (int i = 0; i < n; i++) {
+            nodes[i] = _new_node(std::move(keys[i]));
+        }
+        std::vector<char> dup(n, 0);
+        root = _union(root, nodes.data(), n, dup.data(), _parallel_tasks());
+        if (root != nullptr) {
+            root->parent = nullptr;
+        }
+        int added = n;
+        for (int i = 0; i < n; i++) {
+            if (dup[i]) {
+                _delete_node(nodes[i]);
+                added--;
+            }
+        }
+        return added;
+    }
+
+    /**
+     * @brief Metodo que remove um lote de elementos, dividindo e juntando a árvore como em
+     * insert_batch, com as metades processadas em paralelo
+     *
+     * @param first Início do lote
+     * @param last Fim do lote
+     * @return Quantidade de elementos efetivamente removidos
+     */
+    template <typename It>
+    int erase_batch(It first, It last) {
+        std::vector<T> keys = _sorted_unique(first, last);
+        int n = static_cast<int>(keys.size());
+        std::vector<Node<T>*> removed(n, nullptr);
+        root = _difference(root, keys.data(), n, removed.data(), _parallel_tasks());
+        if (root != nullptr) {
+            root->parent = nullptr;
+        }
+        int count = 0;
+        for (Node<T>* node : removed) {
+            if (node != nullptr) {
+                _delete_node(node);
+                count++;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Metodo que une other a esta árvore sem copiar nodes: as árvores são divididas e
+     * juntadas (split/join) com custo O(m log(n/m + 1)) para m = min(|this|, |other|), e as
+     * subárvores independentes são resolvidas em paralelo. A árvore maior fica com os nodes da
+     * menor, inclusive o seu pool; other fica vazia.
+     *
+     * @param other Árvore a ser unida (movida)
+     */
+    void unite(AVL_Tree&& other) {
+        if (&other == this || other.root == nullptr) {
+            return;
+        }
+        if (size() < other.size()) {
+            std::swap(root, other.root);
+            pool.swap(other.pool);
+        }
+        pool.merge(other.pool);
+        Node<T>* small = other.root;
+        other.root = nullptr;
+        std::vector<Node<T>*> dups;
+        root = _unite(root, small, dups, _parallel_tasks());
+        root->parent = nullptr;
+        _delete_nodes(dups);
+    }
+
+    /**
+     * @brief Versão de unite que copia other antes de unir
+     *
+     * @param other Árvore a ser unida
+     */
+    void unite(const AVL_Tree& other) {
+        if (&other != this) {
+            unite(AVL_Tree(other));
+        }
+    }
+
+    /**
+     * @brief Metodo que mantém na árvore só os elementos que também estão em other, por
+     * split/join em O(m log(n/m + 1)) com as subárvores resolvidas em paralelo. Se other é muito
+     * menor e T tem destrutor trivial, a árvore é remontada só com as chaves de other encontradas,
+     * sem visitar os nodes descartados.
+     *
+     * @param other Árvore consultada
+     */
+    void intersect(const AVL_Tree& other) {
+        if (&other == this) {
+            return;
+        }
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            if (static_cast<long long>(other.size()) * SMALL_SIDE_RATIO < size()) {
+                std::vector<T> keep;
+                for (const T& key : other) {
+                    if (contains(key)) {
+                        keep.push_back(key);
+                    }
+                }
+                clear();
+                auto it = keep.begin();
+                pool.reserve(keep.size());
+                root = _build(it, static_cast<int>(keep.size()));
+                return;
+            }
+        }
+        std::vector<Node<T>*> dropped;
+        root = _intersect(root, other.root, dropped, _parallel_tasks());
+        if (root != nullptr) {
+            root->parent = nullptr;
+        }
+        _delete_nodes(dropped);
+    }
+
+    /**
+     * @brief Metodo que tira da árvore os elementos que estão em other, por split/join em
+     * O(m log(n/m + 1)) com as subárvores resolvidas em paralelo
+     *
+     * @param other Árvore consultada
+     */
+    void subtract(const AVL_Tree& other) {
+        if (&other == this) {
+            clear();
+            return;
+        }
+        std::vector<Node<T>*> dropped;
+        root = _subtract(root, other.root, dropped, _parallel_tasks());
+        if (root != nullptr) {
+            root->parent = nullptr;
+        }
+        _delete_nodes(dropped);
+    }
+
+    /**
+     * @brief Método que remove todos os elementos da árvore. Se T tem destrutor trivial, os blocos
+     * são liberados de uma vez, sem percorrer os nodes.
+     *
+     */
+    void clear() {
+        stats_.deallocation(size(root));
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            _destroy(root);
+        }
+        pool.release();
+        root = nullptr;
+    }
+
+    /**
+     * @brief Método que retorna uma fotografia dos contadores de instrumentação. Só existe quando
+     * a política Stats tem snapshot(), como CountingStats.
+     *
+     * @return Contadores acumulados desde a criação ou o último reset_stats
+     */
+    template <typename S = Stats>
+    auto stats() const -> decltype(std::declval<const S&>().snapshot()) {
+        return stats_.snapshot();
+    }
+
+    /**
+     * @brief Método que zera os contadores de instrumentação
+     *
+     */
+    template <typename S = Stats>
+    auto reset_stats() -> decltype(std::declval<S&>().reset()) {
+        stats_.reset();
+    }
+
+    /**
+     * @brief Método que troca o conteúdo de duas árvores AVL. Apenas troca as raízes e os pools;
+     * os contadores de instrumentação ficam com cada objeto.
+     *
+     * @param other Árvore AVL a ser trocada
+     */
+    void swap(AVL_Tree& other) noexcept {
+        std::swap(root, other.root);
+        pool.swap(other.pool);
+        std::swap(compare, other.compare);
+    }
+
+    /**
+     * @brief Método que retorna um iterador para o menor elemento da árvore
+     *
+     * @return Iterador para o início da ordem
+     */
+    iterator begin() const {
+        Node<T>* p = root;
+        while (p != nullptr && p->left != nullptr) {
+            p = p->left;
+        }
+        return iterator(p, this);
+    }
+
+    /**
+     * @brief Método que retorna um iterador para depois do maior elemento da árvore
+     *
+     * @return Iterador para o fim da ordem
+     */
+    iterator end() const {
+        return iterator(nullptr, this);
+    }
+
+    /**
+     * @brief Método que retorna um iterador para o primeiro elemento maior ou igual a key
+     *
+     * @param key Chave de referência (não precisa estar na árvore)
+     * @return Iterador para o elemento, ou end() se não existir
+     */
+    iterator lower_bound(const T& key) const {
+        return iterator(_lower_bound(key), this);
+    }
+
+    /**
+     * @brief Versão de lower_bound para chaves de outro tipo, disponível com comparador transparente
+     *
+     * @param key Chave de referência
+     * @return Iterador para o elemento, ou end() se não existir
+     */
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator lower_bound(const K& key) const {
+        return iterator(_lower_bound(key), this);
+    }
+
+    /**
+     * @brief Método que retorna um iterador para o primeiro elemento maior que key
+     *
+     * @param key Chave de referência (não precisa estar na árvore)
+     * @return Iterador para o elemento, ou end() se não existir
+     */
+    iterator upper_bound(const T& key) const {
+        return iterator(_upper_bound(key), this);
+    }
+
+    /**
+     * @brief Versão de upper_bound para chaves de outro tipo, disponível com comparador transparente
+     *
+     * @param key Chave de referência
+     * @return Iterador para o elemento, ou end() se não existir
+     */
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator upper_bound(const K& key) const {
+        return iterator(_upper_bound(key), this);
+    }
+
+    /**
+     * @brief Método que retorna o intervalo de elementos iguais a key, ou seja, o par
+     * (lower_bound, upper_bound), em uma única descida
+     *
+     * @param key Chave de referência
+     * @return Par de iteradores; vazio se key não está na árvore
+     */
+    std::pair<iterator, iterator> equal_range(const T& key) const {
+        auto [node, found] = _equal_range(key);
+        iterator it(node, this);
+        return {it, found ? std::next(it) : it};
+    }
+
+    /**
+     * @brief Versão de equal_range para chaves de outro tipo, disponível com comparador transparente
+     *
+     * @param key Chave de referência
+     * @return Par de iteradores; vazio se key não está na árvore
+     */
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K& key) const {
+        auto [node, found] = _equal_range(key);
+        iterator it(node, this);
+        return {it, found ? std::next(it) : it};
+    }
+
+    /**
+     * @brief Método que visita, em ordem, todos os elementos no intervalo fechado [lo, hi].
+     * Subárvores fora do intervalo não são visitadas, então o custo é O(log n + k) para k
+     * elementos visitados.
+     *
+     * @param lo Limite inferior
+     * @param hi Limite superior
+     * @param visit Função chamada com cada elemento do intervalo
+     */
+    template <typename Visitor>
+    void for_each_in_range(const T& lo, const T& hi, Visitor visit) const {
+        _for_each_in_range(root, lo, hi, visit);
+    }
+
+    /**
+     * @brief Método que retorna o menor elemento da árvore
+     *
+     * @return Valor do menor elemento
+     */
+    T& minimum() {
+        return _minimum(root);
+    }
+
+    /**
+     * @brief Método que retorna o maior elemento da árvore
+     *s
+     * @return Valor do maior elemento
+     */
+    T& maximum() {
+        return _maximum(root);
+    }
+
+    /**
+     * @brief Método que retorna o sucessor de um elemento. Uma única descida verifica se a chave
+     * está na árvore e encontra o sucessor.
+     *
+     * @param key Elemento a ser verificado
+     * @return Sucessor do elemento
+     */
+    T& successor(const T& key) {
+        int levels = 0;
+        Node<T>* p = root;
+        Node<T>* sucessor = nullptr;
+        bool found = false;
+        while (p != nullptr) {
+            levels++;
+            auto c = cmp(key, p->data);
+            if (c < 0) {
+                sucessor = p;
+                p = p->left;
+            } else {
+                found = found || c == 0;
+                p = p->right;
+            }
+        }
+        stats_.descent(levels);
+        if (!found) {
+            throw std::runtime_error("Elemento não está no conjunto");
+        }
+        if (sucessor == nullptr) {
+            throw std::runtime_error("Não existe sucessor");
+        }
+        return sucessor->data;
+    }
+
+    /**
+     * @brief Método que retorna o antecessor de um elemento. Uma única descida verifica se a chave
+     * está na árvore e encontra o antecessor.
+     *
+     * @param key Elemento a ser verificado
+     * @return Antecessor do elemento
+     */
+    T& predecessor(const T& key) {
+        int levels = 0;
+        Node<T>* p = root;
+        Node<T>* pred = nullptr;
+        bool found = false;
+        while (p != nullptr) {
+            levels++;
+            auto c = cmp(key, p->data);
+            if (c > 0) {
+                pred = p;
+                p = p->right;
+            } else {
+                found = found || c == 0;
+                p = p->left;
+            }
+        }
+        stats_.descent(levels);
+        if (!found) {
+            throw std::runtime_error("Elemento não está no conjunto");
+        }
+        if (pred == nullptr) {
+            throw std::runtime_error("Não existe antecessor");
+        }
+        return pred->data;
+    }
+
+    /**
+     * @brief Método que retorna a quantidade de elementos da árvore em O(1)
+     *
+     * @return Quantidade de elementos
+     */
+    int size() const {
+        return size(root);
+    }
+
+    /**
+     * @brief Método que retorna quantos elementos da árvore são menores que key. A chave não
+     * precisa estar na árvore.
+     *
+     * @param key Chave de referência
+     * @return Posição que key ocupa (ou ocuparia) na ordem, começando em 0
+     */
+    int rank(const T& key) const {
+        return _count_less(key, false);
+    }
+
+    /**
+     * @brief Método que retorna o k-ésimo menor elemento da árvore, com k começando em 0
+     *
+     * @param k Posição do elemento na ordem
+     * @return Elemento na posição k
+     */
+    T& select(int k) {
+        if (k < 0 || k >= size(root)) {
+            throw std::runtime_error("Posição inválida");
+        }
+        Node<T>* p = root;
+        while (true) {
+            int left = size(p->left);
+            if (k < left) {
+                p = p->left;
+            } else if (k > left) {
+                k -= left + 1;
+                p = p->right;
+            } else {
+                return p->data;
+            }
+        }
+    }
+
+    /**
+     * @brief Método que conta os elementos no intervalo fechado [lo, hi]
+     *
+     * @param lo Limite inferior
+     * @param hi Limite superior
+     * @return Quantidade de elementos no intervalo
+     */
+    int count_range(const T& lo, const T& hi) const {
+        if (cmp(hi, lo) < 0) {
+            return 0;
+        }
+        return _count_less(hi, true) - _count_less(lo, false);
+    }
+
+    /**
+     * @brief Método que retorna uma string com a representação da árvore em pré-ordem
+     *
+     * @return String com a representação da árvore em pré-ordem
+     */
+    std::string inOrder() {
+        return _inOrder(root);
+    }
+
+    /**
+     * @brief Método que procura um elemento
+     *
+     * @param key Chave procurada
+     * @return Iterador para o elemento, ou end() se não existir
+     */
+    iterator find(const T& key) const {
+        return iterator(_find(key), this);
+    }
+
+    /**
+     * @brief Versão de find para chaves de outro tipo, disponível com comparador transparente
+     *
+     * @param key Chave procurada
+     * @return Iterador para o elemento, ou end() se não existir
+     */
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator find(const K& key) const {
+        return iterator(_find(key), this);
+    }
+
+    /**
+     * @brief Função pública que verifica se a árvore contém a chave val
+     *
+     * @param val chave a ser verificada
+     * @return true se contém,
+     * @return false caso contrário
+     */
+    bool contains(const T& val) const {
+        return _find(val) != nullptr;
+    }
+
+    /**
+     * @brief Versão de contains para chaves de outro tipo, disponível com comparador transparente
      *
      * @param val chave a ser verificada
      * @return true se contém,
      * @return false caso contrário
      */
-    bool contains(const T& val) {
-        return _contains(root, val) != nullptr;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    bool contains(const K& val) const {
+        return _find(val) != nullptr;
     }
 };
 
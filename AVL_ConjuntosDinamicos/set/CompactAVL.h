@@ -0,0 +1,414 @@
+/**
+ * @file CompactAVL.h
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief TAD para representar uma árvore AVL compacta. Os nodes ficam em um vetor contíguo, os
+ * filhos são índices de 32 bits e cada node guarda só o fator de balanceamento (2 bits) no lugar
+ * da altura.
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#ifndef COMPACTAVL_H
+#define COMPACTAVL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Classe que representa uma árvore AVL com layout compacto baseado em índices
+ *
+ * @tparam T Tipo de dado a ser armazenado na árvore
+ */
+template <typename T>
+class Compact_AVL_Tree {
+   private:
+    static constexpr std::uint32_t NIL = (1u << 30) - 1;  // indice que representa a ausencia de node
+    static constexpr int MAX_HEIGHT = 64;                  // altura maxima de uma AVL com ate 2^30 nodes
+
+    struct Node {
+        T data;               // dado armazenado no node
+        std::uint32_t left;   // indice do filho esquerdo
+        std::uint32_t right;  // 30 bits de baixo: indice do filho direito; 2 bits de cima: balanceamento + 1
+
+        /**
+         * @brief Construtor do Node. O node começa sem filhos e balanceado.
+         *
+         * @param data Dado a ser armazenado no node
+         */
+        Node(const T& data) : data(data), left(NIL), right(NIL | (1u << 30)) {}
+    };
+
+    std::vector<Node> nodes{};  // nodes da arvore, sem buracos
+    std::uint32_t root{NIL};    // indice da raiz
+
+    /**
+     * @brief Método privado que retorna o filho de um node
+     *
+     * @param i Índice do node
+     * @param dir 0 para o filho esquerdo, 1 para o direito
+     * @return Índice do filho
+     */
+    std::uint32_t child(std::uint32_t i, int dir) {
+        return dir ? (nodes[i].right & NIL) : nodes[i].left;
+    }
+
+    /**
+     * @brief Método privado que altera o filho de um node, preservando o fator de balanceamento
+     *
+     * @param i Índice do node
+     * @param dir 0 para o filho esquerdo, 1 para o direito
+     * @param c Índice do novo filho
+     */
+    void set_child(std::uint32_t i, int dir, std::uint32_t c) {
+        if (dir) {
+            nodes[i].right = (nodes[i].right & ~NIL) | c;
+        } else {
+            nodes[i].left = c;
+        }
+    }
+
+    /**
+     * @brief Método privado que retorna o fator de balanceamento (altura direita - altura esquerda)
+     *
+     * @param i Índice do node
+     * @return -1, 0 ou 1
+     */
+    int balance(std::uint32_t i) {
+        return static_cast<int>(nodes[i].right >> 30) - 1;
+    }
+
+    /**
+     * @brief Método privado que altera o fator de balanceamento de um node
+     *
+     * @param i Índice do node
+     * @param b Novo fator (-1, 0 ou 1)
+     */
+    void set_balance(std::uint32_t i, int b) {
+        nodes[i].right = (nodes[i].right & NIL) | (static_cast<std::uint32_t>(b + 1) << 30);
+    }
+
+    /**
+     * @brief Método privado que troca o filho dir de parent (ou a raiz, se parent é NIL)
+     *
+     * @param parent Índice do pai
+     * @param dir Lado do filho
+     * @param c Índice do novo filho
+     */
+    void relink(std::uint32_t parent, int dir, std::uint32_t c) {
+        if (parent == NIL) {
+            root = c;
+        } else {
+            set_child(parent, dir, c);
+        }
+    }
+
+    /**
+     * @brief Método privado que sobe o filho do lado dir de p. Com dir = 1 é a rotação à esquerda,
+     * com dir = 0 é a rotação à direita. Os fatores de balanceamento são ajustados por quem chama.
+     *
+     * @param p Node a ser rotacionado
+     * @param dir Lado do filho que sobe
+     * @return Índice da nova raiz da subárvore
+     */
+    std::uint32_t rotate(std::uint32_t p, int dir) {
+        std::uint32_t u = child(p, dir);
+        set_child(p, dir, child(u, !dir));
+        set_child(u, !dir, p);
+        return u;
+    }
+
+    /**
+     * @brief Método privado que regula um node cujo fator de balanceamento chegou a ±2. Como o
+     * fator não cabe em 2 bits, o lado mais alto é passado como parâmetro.
+     *
+     * @param p Node a ser regulado
+     * @param dir Lado mais alto (1 se o fator é +2, 0 se é -2)
+     * @param shorter Saída: true se a subárvore ficou mais baixa do que com o fator ±2
+     * @return Índice da nova raiz da subárvore
+     */
+    std::uint32_t rebalance(std::uint32_t p, int dir, bool& shorter) {
+        int s = dir ? 1 : -1;
+        std::uint32_t c = child(p, dir);
+        int cb = balance(c);
+        if (cb == s) {  // rotacao simples
+            std::uint32_t top = rotate(p, dir);
+            set_balance(p, 0);
+            set_balance(c, 0);
+            shorter = true;
+            return top;
+        }
+        if (cb == 0) {  // rotacao simples que so ocorre na remocao
+            std::uint32_t top = rotate(p, dir);
+            set_balance(p, s);
+            set_balance(c, -s);
+            shorter = false;
+            return top;
+        }
+        std::uint32_t g = child(c, !dir);  // rotacao dupla
+        int gb = balance(g);
+        set_child(p, dir, rotate(c, !dir));
+        std::uint32_t top = rotate(p, dir);
+        set_balance(p, (gb == s) ? -s : 0);
+        set_balance(c, (gb == -s) ? s : 0);
+        set_balance(g, 0);
+        shorter = true;
+        return top;
+    }
+
+    /**
+     * @brief Método privado que tira o node i do vetor. O último node do vetor é movido para a
+     * posição i e o link que apontava para ele é corrigido, então o vetor nunca tem buracos.
+     *
+     * @param i Índice de um node que já não está ligado à árvore
+     */
+    void release(std::uint32_t i) {
+        std::uint32_t last = static_cast<std::uint32_t>(nodes.size() - 1);
+        if (i != last) {
+            std::uint32_t parent = NIL;
+            int dir = 0;
+            std::uint32_t q = root;
+            while (q != last) {
+                parent = q;
+                dir = nodes[q].data < nodes[last].data;
+                q = child(q, dir);
+            }
+            relink(parent, dir, i);
+            nodes[i] = std::move(nodes[last]);
+        }
+        nodes.pop_back();
+    }
+
+   public:
+    /**
+     * @brief Construtor padrão da classe Compact_AVL_Tree
+     *
+     */
+    Compact_AVL_Tree() = default;
+
+    /**
+     * @brief Metodo para adicionar um elemento na arvore
+     *
+     * @param data
+     * @return true se o elemento foi adicionado, false se já existia
+     */
+    bool add(const T& data) {
+        std::uint32_t path[MAX_HEIGHT];
+        int dirs[MAX_HEIGHT];
+        int depth = 0;
+        std::uint32_t p = root;
+        while (p != NIL) {
+            if (data == nodes[p].data) {  // chave ja existe
+                return false;
+            }
+            int dir = nodes[p].data < data;
+            path[depth] = p;
+            dirs[depth++] = dir;
+            p = child(p, dir);
+        }
+        if (nodes.size() >= NIL) {
+            throw std::runtime_error("Capacidade da árvore esgotada");
+        }
+        std::uint32_t n = static_cast<std::uint32_t>(nodes.size());
+        nodes.emplace_back(data);
+        relink(depth > 0 ? path[depth - 1] : NIL, depth > 0 ? dirs[depth - 1] : 0, n);
+
+        while (depth > 0) {  // a subarvore de path[depth] cresceu do lado dirs[depth]
+            p = path[--depth];
+            int s = dirs[depth] ? 1 : -1;
+            int b = balance(p) + s;
+            if (b == 0) {  // altura mantida
+                set_balance(p, 0);
+                break;
+            }
+            if (b == s) {  // cresceu, continua subindo
+                set_balance(p, b);
+                continue;
+            }
+            bool shorter;
+            std::uint32_t top = rebalance(p, dirs[depth], shorter);
+            relink(depth > 0 ? path[depth - 1] : NIL, depth > 0 ? dirs[depth - 1] : 0, top);
+            break;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Metodo para remover um elemento da arvore
+     *
+     * @param data
+     * @return true se o elemento foi removido, false se não estava na árvore
+     */
+    bool remove(const T& data) {
+        std::uint32_t path[MAX_HEIGHT];
+        int dirs[MAX_HEIGHT];
+        int depth = 0;
+        std::uint32_t p = root;
+        while (p != NIL && !(data == nodes[p].data)) {
+            int dir = nodes[p].data < data;
+            path[depth] = p;
+            dirs[depth++] = dir;
+            p = child(p, dir);
+        }
+        if (p == NIL) {  // node nao encontrado
+            return false;
+        }
+        std::uint32_t target = p;
+        if (nodes[p].left != NIL && child(p, 1) != NIL) {  // dois filhos: sai o sucessor
+            path[depth] = p;
+            dirs[depth++] = 1;
+            target = child(p, 1);
+            while (nodes[target].left != NIL) {
+                path[depth] = target;
+                dirs[depth++] = 0;
+                target = nodes[target].left;
+            }
+            nodes[p].data = std::move(nodes[target].data);
+        }
+        std::uint32_t c = (nodes[target].left != NIL) ? nodes[target].left : child(target, 1);
+        relink(depth > 0 ? path[depth - 1] : NIL, depth > 0 ? dirs[depth - 1] : 0, c);
+
+        while (depth > 0) {  // a subarvore de path[depth] diminuiu do lado dirs[depth]
+            p = path[--depth];
+            int s = dirs[depth] ? 1 : -1;
+            int b = balance(p) - s;
+            if (b == 0) {  // diminuiu, continua subindo
+                set_balance(p, 0);
+                continue;
+            }
+            if (b == -s) {  // altura mantida
+                set_balance(p, b);
+                break;
+            }
+            bool shorter;
+            std::uint32_t top = rebalance(p, !dirs[depth], shorter);
+            relink(depth > 0 ? path[depth - 1] : NIL, depth > 0 ? dirs[depth - 1] : 0, top);
+            if (!shorter) {
+                break;
+            }
+        }
+        release(target);
+        return true;
+    }
+
+    /**
+     * @brief Método que remove todos os elementos da árvore e devolve a memória do vetor
+     *
+     */
+    void clear() {
+        std::vector<Node>().swap(nodes);
+        root = NIL;
+    }
+
+    /**
+     * @brief Método que reserva espaço para n nodes, evitando realocações do vetor
+     *
+     * @param n Quantidade de nodes
+     */
+    void reserve(std::size_t n) {
+        nodes.reserve(n);
+    }
+
+    /**
+     * @brief Método que devolve a capacidade não usada do vetor de nodes
+     *
+     */
+    void shrink_to_fit() {
+        nodes.shrink_to_fit();
+    }
+
+    /**
+     * @brief Método que retorna a quantidade de elementos da árvore
+     *
+     * @return Quantidade de elementos
+     */
+    int size() {
+        return static_cast<int>(nodes.size());
+    }
+
+    /**
+     * @brief Método que verifica se a árvore está vazia
+     *
+     * @return true se está vazia, false caso contrário
+     */
+    bool empty() {
+        return nodes.empty();
+    }
+
+    /**
+     * @brief Método que retorna quantos bytes a árvore ocupa, incluindo a capacidade reservada
+     *
+     * @return Quantidade de bytes
+     */
+    std::size_t memory_usage() {
+        return sizeof(*this) + nodes.capacity() * sizeof(Node);
+    }
+
+    /**
+     * @brief Função pública que verifica se a árvore contém a chave val
+     *
+     * @param val chave a ser verificada
+     * @return true se contém,
+     * @return false caso contrário
+     */
+    bool contains(const T& val) {
+        std::uint32_t p = root;
+        while (p != NIL && !(val == nodes[p].data)) {
+            p = child(p, nodes[p].data < val);
+        }
+        return p != NIL;
+    }
+
+    /**
+     * @brief Método que retorna o menor elemento da árvore
+     *
+     * @return Valor do menor elemento
+     */
+    T& minimum() {
+        std::uint32_t p = root;
+        while (nodes[p].left != NIL) {
+            p = nodes[p].left;
+        }
+        return nodes[p].data;
+    }
+
+    /**
+     * @brief Método que retorna o maior elemento da árvore
+     *
+     * @return Valor do maior elemento
+     */
+    T& maximum() {
+        std::uint32_t p = root;
+        while (child(p, 1) != NIL) {
+            p = child(p, 1);
+        }
+        return nodes[p].data;
+    }
+
+    /**
+     * @brief Método que visita todos os elementos em ordem crescente, usando uma pilha de índices
+     *
+     * @param visit Função chamada com cada elemento
+     */
+    template <typename Visitor>
+    void for_each(Visitor visit) {
+        std::uint32_t stack[MAX_HEIGHT];
+        int top = 0;
+        std::uint32_t p = root;
+        while (p != NIL || top > 0) {
+            while (p != NIL) {
+                stack[top++] = p;
+                p = nodes[p].left;
+            }
+            p = stack[--top];
+            visit(nodes[p].data);
+            p = child(p, 1);
+        }
+    }
+};
+
+#endif  // COMPACTAVL_H
@@ -0,0 +1,736 @@
+/**
+ * @file ConcurrentAVL.h
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief TAD para representar uma árvore AVL com leituras concorrentes sem trava e um único
+ * escritor. O escritor copia o caminho alterado e publica a nova raiz de forma atômica; os nodes
+ * substituídos são liberados por recuperação baseada em épocas (epoch-based reclamation).
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#ifndef CONCURRENTAVL_H
+#define CONCURRENTAVL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "AVL.h"
+#include "NodePool.h"
+
+/**
+ * @brief Domínio global de épocas. Cada thread leitora anuncia em seu slot a época em que entrou;
+ * a época global só avança quando todas as threads ativas já estão nela. Um objeto retirado na
+ * época e pode ser liberado quando a época global chega a e + 2, pois nenhum leitor ainda ativo
+ * pode ter visto o objeto.
+ *
+ * Os slots ficam em blocos encadeados. Quando todos estão reservados, a thread que chega acrescenta
+ * um bloco novo ao fim da lista com compare_exchange, então não há limite de threads leitoras. Os
+ * blocos só são liberados junto com o domínio; slots de threads encerradas são reaproveitados.
+ *
+ */
+class EpochDomain {
+   public:
+    static constexpr int BLOCK_SLOTS = 64;  // slots por bloco da lista
+
+   private:
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> active{0};  // epoca anunciada pela thread (0 = fora de leitura)
+        std::atomic<bool> used{false};         // slot reservado por alguma thread
+    };
+
+    struct Block {
+        Slot slots[BLOCK_SLOTS];
+        std::atomic<Block*> next{nullptr};  // proximo bloco da lista
+    };
+
+    /**
+     * @brief Registro de uma thread no domínio. Reserva um slot na primeira leitura da thread e o
+     * devolve quando a thread termina.
+     *
+     */
+    struct Registration {
+        Slot* slot{};  // slot reservado
+        int depth{0};  // guardas aninhadas abertas pela thread
+
+        explicit Registration(EpochDomain& domain) : slot(domain.acquire()) {}
+
+        ~Registration() {
+            slot->active.store(0);
+            slot->used.store(false);
+        }
+    };
+
+    std::atomic<std::uint64_t> epoch{1};  // epoca global
+    Block head;                           // primeiro bloco de slots
+
+    /**
+     * @brief Método privado que reserva um slot livre. Percorre os blocos e, se todos estiverem
+     * cheios, encadeia um novo no fim; se outra thread encadear antes, usa o bloco dela e descarta o
+     * próprio.
+     *
+     * @return Slot reservado para a thread atual
+     */
+    Slot* acquire() {
+        Block* block = &head;
+        while (true) {
+            for (Slot& slot : block->slots) {
+                bool expected = false;
+                if (!slot.used.load(std::memory_order_relaxed) &&
+                    slot.used.compare_exchange_strong(expected, true)) {
+                    return &slot;
+                }
+            }
+            Block* next = block->next.load();
+            if (next == nullptr) {
+                Block* fresh = new Block();
+                fresh->slots[0].used.store(true, std::memory_order_relaxed);
+                if (block->next.compare_exchange_strong(next, fresh)) {
+                    return &fresh->slots[0];
+                }
+                delete fresh;  // next agora aponta para o bloco de outra thread
+            }
+            block = next;
+        }
+    }
+
+    EpochDomain() = default;
+
+    ~EpochDomain() {
+        Block* block = head.next.load();
+        while (block != nullptr) {
+            Block* next = block->next.load();
+            delete block;
+            block = next;
+        }
+    }
+
+    /**
+     * @brief Método privado que retorna o registro da thread atual, criando-o se necessário
+     *
+     * @return Registro da thread
+     */
+    Registration& registration() {
+        static thread_local Registration reg(*this);
+        return reg;
+    }
+
+   public:
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    /**
+     * @brief Retorna o domínio compartilhado por todas as árvores concorrentes
+     *
+     * @return Domínio global
+     */
+    static EpochDomain& instance() {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    /**
+     * @brief Guarda RAII de leitura. Enquanto existir, nenhum node que a thread possa alcançar é
+     * liberado. Guardas podem ser aninhadas.
+     *
+     */
+    class Guard {
+       private:
+        Registration& reg;
+
+       public:
+        /**
+         * @brief Anuncia a época da thread. O anúncio é seguido de uma barreira seq_cst (ordem
+         * StoreLoad) antes de reler a época global; se ela avançou nesse meio tempo, o anúncio é
+         * refeito. Assim, qualquer leitura da raiz feita depois já é visível para try_advance, que
+         * não pode passar duas épocas à frente desta thread.
+         *
+         */
+        explicit Guard(EpochDomain& domain = instance()) : reg(domain.registration()) {
+            if (reg.depth++ == 0) {
+                std::atomic<std::uint64_t>& active = reg.slot->active;
+                std::uint64_t e = domain.epoch.load();
+                while (true) {
+                    active.store(e, std::memory_order_seq_cst);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    std::uint64_t now = domain.epoch.load(std::memory_order_seq_cst);
+                    if (now == e) {
+                        break;
+                    }
+                    e = now;
+                }
+            }
+        }
+
+        ~Guard() {
+            if (--reg.depth == 0) {
+                reg.slot->active.store(0, std::memory_order_release);
+            }
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    };
+
+    /**
+     * @brief Retorna a época global atual
+     *
+     * @return Época atual
+     */
+    std::uint64_t current() const {
+        return epoch.load();
+    }
+
+    /**
+     * @brief Tenta avançar a época global. Só avança se nenhuma thread ativa, em nenhum bloco,
+     * estiver em uma época anterior.
+     *
+     * @return true se a época avançou
+     */
+    bool try_advance() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);  // pareia com a barreira de Guard
+        std::uint64_t e = epoch.load();
+        for (const Block* block = &head; block != nullptr; block = block->next.load()) {
+            for (const Slot& slot : block->slots) {
+                if (slot.used.load()) {
+                    std::uint64_t a = slot.active.load();
+                    if (a != 0 && a != e) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return epoch.compare_exchange_strong(e, e + 1);
+    }
+};
+
+/**
+ * @brief Classe que representa uma árvore AVL com um escritor e leitores concorrentes sem trava.
+ * Os nodes publicados nunca são alterados: o escritor copia o caminho até a raiz, publica a nova
+ * raiz com uma escrita atômica e retira os nodes antigos no domínio de épocas. Cada leitura vê um
+ * snapshot consistente da árvore.
+ *
+ * Apenas uma thread pode chamar add, remove e clear ao mesmo tempo; as demais operações podem ser
+ * chamadas por qualquer quantidade de threads, inclusive durante uma escrita.
+ *
+ * @tparam T Tipo de dado a ser armazenado na árvore
+ * @tparam Compare Comparador de três vias, como em AVL_Tree
+ */
+template <typename T, typename Compare = three_way>
+class Concurrent_AVL_Tree {
+   private:
+    struct Node {
+        const T data;       // dado armazenado no node
+        Node* const left;   // filho esquerdo
+        Node* const right;  // filho direito
+        const int height;   // altura do node
+        const int size;     // quantidade de nodes na subarvore
+        bool fresh{true};   // criado pela escrita em andamento (so o escritor le este campo)
+
+        Node(const T& data, Node* left, Node* right)
+            : data(data),
+              left(left),
+              right(right),
+              height(1 + std::max(Concurrent_AVL_Tree::height(left), Concurrent_AVL_Tree::height(right))),
+              size(1 + Concurrent_AVL_Tree::size(left) + Concurrent_AVL_Tree::size(right)) {}
+    };
+
+    static constexpr std::size_t RECLAIM_BATCH = 64;  // nodes retirados antes de tentar liberar
+
+    std::atomic<Node*> root{nullptr};                     // raiz publicada
+    Compare compare{};                                    // comparador de tres vias das chaves
+    NodePool<Node> pool{};                                // so o escritor aloca e libera
+    std::vector<Node*> created{};                         // nodes criados pela escrita em andamento
+    std::vector<Node*> garbage{};                         // nodes antigos tirados pela escrita em andamento
+    std::deque<std::pair<std::uint64_t, Node*>> limbo{};  // nodes retirados e sua epoca
+
+    /**
+     * @brief Método privado que retorna a altura de um node
+     *
+     * @param node
+     * @return int
+     */
+    static int height(const Node* node) {
+        return (node != nullptr) ? node->height : 0;
+    }
+
+    /**
+     * @brief Método privado que retorna a quantidade de nodes da subárvore de um node
+     *
+     * @param node
+     * @return int
+     */
+    static int size(const Node* node) {
+        return (node != nullptr) ? node->size : 0;
+    }
+
+    /**
+     * @brief Método privado que cria um node ainda não publicado
+     *
+     * @return Novo node
+     */
+    Node* make(const T& data, Node* l, Node* r) {
+        Node* node = pool.create(data, l, r);
+        created.push_back(node);
+        return node;
+    }
+
+    /**
+     * @brief Método privado que descarta um node que saiu da nova versão. Se ele nunca foi
+     * publicado, é liberado na hora; senão, vai para a lista de retirada.
+     *
+     * @param node Node descartado
+     */
+    void discard(Node* node) {
+        if (node->fresh) {
+            created.erase(std::find(created.begin(), created.end(), node));
+            pool.destroy(node);
+        } else {
+            garbage.push_back(node);
+        }
+    }
+
+    /**
+     * @brief Método privado que cria um node com os filhos dados, rotacionando quando as alturas
+     * dos filhos diferem em 2. Os nodes que a rotação substitui são descartados.
+     *
+     * @param data Dado do node
+     * @param l Filho esquerdo
+     * @param r Filho direito
+     * @return Raiz da nova subárvore balanceada
+     */
+    Node* make_balanced(const T& data, Node* l, Node* r) {
+        if (height(l) > height(r) + 1) {
+            Node* top;
+            if (height(l->left) >= height(l->right)) {  // rotacao a direita
+                top = make(l->data, l->left, make(data, l->right, r));
+            } else {  // rotacao dupla esquerda-direita
+                Node* lr = l->right;
+                top = make(lr->data, make(l->data, l->left, lr->left), make(data, lr->right, r));
+                discard(lr);
+            }
+            discard(l);
+            return top;
+        }
+        if (height(r) > height(l) + 1) {
+            Node* top;
+            if (height(r->right) >= height(r->left)) {  // rotacao a esquerda
+                top = make(r->data, make(data, l, r->left), r->right);
+            } else {  // rotacao dupla direita-esquerda
+                Node* rl = r->left;
+                top = make(rl->data, make(data, l, rl->left), make(r->data, rl->right, r->right));
+                discard(rl);
+            }
+            discard(r);
+            return top;
+        }
+        return make(data, l, r);
+    }
+
+    /**
+     * @brief Método privado que adiciona um elemento copiando o caminho
+     *
+     * @param p Raiz da subárvore
+     * @param data Dado a ser adicionado
+     * @param added Saída: true se o elemento foi adicionado
+     * @return Raiz da nova versão da subárvore
+     */
+    Node* _add(Node* p, const T& data, bool& added) {
+        if (p == nullptr) {  // subarvore vazia
+            added = true;
+            return make(data, nullptr, nullptr);
+        }
+        auto c = compare(data, p->data);
+        if (c == 0) {  // chave ja existe
+            return p;
+        }
+        Node* q;
+        if (c < 0) {
+            Node* l = _add(p->left, data, added);
+            if (!added) {
+                return p;
+            }
+            q = make_balanced(p->data, l, p->right);
+        } else {
+            Node* r = _add(p->right, data, added);
+            if (!added) {
+                return p;
+            }
+            q = make_balanced(p->data, p->left, r);
+        }
+        discard(p);
+        return q;
+    }
+
+    /**
+     * @brief Método privado que remove o menor elemento de uma subárvore não vazia
+     *
+     * @param p Raiz da subárvore
+     * @param min Saída: node que tinha o menor elemento (já descartado)
+     * @return Raiz da nova versão da subárvore
+     */
+    Node* _remove_min(Node* p, Node*& min) {
+        if (p->left == nullptr) {
+            min = p;
+            return p->right;
+        }
+        Node* q = make_balanced(p->data, _remove_min(p->left, min), p->right);
+        discard(p);
+        return q;
+    }
+
+    /**
+     * @brief Método privado que remove um elemento copiando o caminho
+     *
+     * @param p Raiz da subárvore
+     * @param data Dado a ser removido
+     * @param removed Saída: true se o elemento foi removido
+     * @return Raiz da nova versão da subárvore
+     */
+    Node* _remove(Node* p, const T& data, bool& removed) {
+        if (p == nullptr) {  // node nao encontrado
+            return p;
+        }
+        auto c = compare(data, p->data);
+        Node* q;
+        if (c < 0) {
+            Node* l = _remove(p->left, data, removed);
+            if (!removed) {
+                return p;
+            }
+            q = make_balanced(p->data, l, p->right);
+        } else if (c > 0) {
+            Node* r = _remove(p->right, data, removed);
+            if (!removed) {
+                return p;
+            }
+            q = make_balanced(p->data, p->left, r);
+        } else {
+            removed = true;
+            if (p->left == nullptr) {
+                q = p->right;
+            } else if (p->right == nullptr) {
+                q = p->left;
+            } else {
+                Node* min = nullptr;
+                Node* r = _remove_min(p->right, min);
+                q = make_balanced(min->data, p->left, r);
+                discard(min);
+            }
+        }
+        discard(p);
+        return q;
+    }
+
+    /**
+     * @brief Método privado que publica a nova raiz e retira os nodes antigos. Os nodes retirados
+     * de épocas já encerradas são liberados.
+     *
+     * @param new_root Raiz da nova versão
+     */
+    void publish(Node* new_root) {
+        root.store(new_root, std::memory_order_release);
+        for (Node* node : created) {
+            node->fresh = false;
+        }
+        created.clear();
+        EpochDomain& domain = EpochDomain::instance();
+        std::uint64_t e = domain.current();
+        for (Node* node : garbage) {
+            limbo.emplace_back(e, node);
+        }
+        garbage.clear();
+        if (limbo.size() >= RECLAIM_BATCH) {
+            domain.try_advance();
+            reclaim(domain.current());
+        }
+    }
+
+    /**
+     * @brief Método privado que libera os nodes retirados há pelo menos duas épocas
+     *
+     * @param current Época global atual
+     */
+    void reclaim(std::uint64_t current) {
+        while (!limbo.empty() && limbo.front().first + 2 <= current) {
+            pool.destroy(limbo.front().second);
+            limbo.pop_front();
+        }
+    }
+
+    /**
+     * @brief Método privado que destrói uma subárvore publicada (só sem leitores)
+     *
+     * @param node Raiz da subárvore
+     */
+    void _destroy(Node* node) {
+        if (node != nullptr) {
+            _destroy(node->left);
+            _destroy(node->right);
+            pool.destroy(node);
+        }
+    }
+
+    /**
+     * @brief Método privado que carrega a raiz publicada. Deve ser chamado dentro de uma guarda.
+     *
+     * @return Raiz atual
+     */
+    const Node* load_root() const {
+        return root.load(std::memory_order_acquire);
+    }
+
+   public:
+    /**
+     * @brief Construtor padrão da classe Concurrent_AVL_Tree
+     *
+     */
+    Concurrent_AVL_Tree() = default;
+
+    Concurrent_AVL_Tree(const Concurrent_AVL_Tree&) = delete;
+    Concurrent_AVL_Tree& operator=(const Concurrent_AVL_Tree&) = delete;
+
+    /**
+     * @brief Destrutor. Não pode haver leitores nem escritor ativos.
+     *
+     */
+    ~Concurrent_AVL_Tree() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            _destroy(root.load());
+            for (auto& retired : limbo) {
+                pool.destroy(retired.second);
+            }
+        }
+    }
+
+    /**
+     * @brief Metodo para adicionar um elemento (somente o escritor)
+     *
+     * @param data
+     * @return true se o elemento foi adicionado, false se já existia
+     */
+    bool add(const T& data) {
+        bool added = false;
+        Node* new_root = _add(root.load(std::memory_order_relaxed), data, added);
+        if (added) {
+            publish(new_root);
+        }
+        return added;
+    }
+
+    /**
+     * @brief Metodo para remover um elemento (somente o escritor)
+     *
+     * @param data
+     * @return true se o elemento foi removido, false se não estava na árvore
+     */
+    bool remove(const T& data) {
+        bool removed = false;
+        Node* new_root = _remove(root.load(std::memory_order_relaxed), data, removed);
+        if (removed) {
+            publish(new_root);
+        }
+        return removed;
+    }
+
+    /**
+     * @brief Método que esvazia a árvore (somente o escritor). Os nodes vão para a lista de
+     * retirada, pois leitores ainda podem estar neles.
+     *
+     */
+    void clear() {
+        std::vector<Node*> stack;
+        if (Node* r = root.load(std::memory_order_relaxed)) {
+            stack.push_back(r);
+        }
+        while (!stack.empty()) {
+            Node* node = stack.back();
+            stack.pop_back();
+            garbage.push_back(node);
+            if (node->left != nullptr) {
+                stack.push_back(node->left);
+            }
+            if (node->right != nullptr) {
+                stack.push_back(node->right);
+            }
+        }
+        publish(nullptr);
+    }
+
+    /**
+     * @brief Método que retorna a quantidade de elementos em O(1)
+     *
+     * @return Quantidade de elementos
+     */
+    int size() const {
+        EpochDomain::Guard guard;
+        return size(load_root());
+    }
+
+    /**
+     * @brief Método que verifica se a árvore está vazia
+     *
+     * @return true se está vazia, false caso contrário
+     */
+    bool empty() const {
+        return root.load(std::memory_order_acquire) == nullptr;
+    }
+
+    /**
+     * @brief Função pública que verifica, sem trava, se a árvore contém a chave val
+     *
+     * @param val chave a ser verificada
+     * @return true se contém,
+     * @return false caso contrário
+     */
+    bool contains(const T& val) const {
+        EpochDomain::Guard guard;
+        const Node* p = load_root();
+        while (p != nullptr) {
+            auto c = compare(val, p->data);
+            if (c == 0) {
+                return true;
+            }
+            p = (c < 0) ? p->left : p->right;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Método que retorna uma cópia do menor elemento. A cópia é necessária porque o node
+     * pode ser liberado assim que a leitura termina.
+     *
+     * @return Menor elemento
+     */
+    T minimum() const {
+        EpochDomain::Guard guard;
+        const Node* p = load_root();
+        if (p == nullptr) {
+            throw std::runtime_error("Conjunto vazio");
+        }
+        while (p->left != nullptr) {
+            p = p->left;
+        }
+        return p->data;
+    }
+
+    /**
+     * @brief Método que retorna uma cópia do maior elemento
+     *
+     * @return Maior elemento
+     */
+    T maximum() const {
+        EpochDomain::Guard guard;
+        const Node* p = load_root();
+        if (p == nullptr) {
+            throw std::runtime_error("Conjunto vazio");
+        }
+        while (p->right != nullptr) {
+            p = p->right;
+        }
+        return p->data;
+    }
+
+    /**
+     * @brief Método que retorna uma cópia do sucessor de um elemento
+     *
+     * @param key Elemento a ser verificado
+     * @return Sucessor do elemento
+     */
+    T successor(const T& key) const {
+        EpochDomain::Guard guard;
+        const Node* p = load_root();
+        const Node* sucessor = nullptr;
+        bool found = false;
+        while (p != nullptr) {
+            auto c = compare(key, p->data);
+            if (c < 0) {
+                sucessor = p;
+                p = p->left;
+            } else {
+                found = found || c == 0;
+                p = p->right;
+            }
+        }
+        if (!found) {
+            throw std::runtime_error("Elemento não está no conjunto");
+        }
+        if (sucessor == nullptr) {
+            throw std::runtime_error("Não existe sucessor");
+        }
+        return sucessor->data;
+    }
+
+    /**
+     * @brief Método que retorna uma cópia do antecessor de um elemento
+     *
+     * @param key Elemento a ser verificado
+     * @return Antecessor do elemento
+     */
+    T predecessor(const T& key) const {
+        EpochDomain::Guard guard;
+        const Node* p = load_root();
+        const Node* pred = nullptr;
+        bool found = false;
+        while (p != nullptr) {
+            auto c = compare(key, p->data);
+            if (c > 0) {
+                pred = p;
+                p = p->right;
+            } else {
+                found = found || c == 0;
+                p = p->left;
+            }
+        }
+        if (!found) {
+            throw std::runtime_error("Elemento não está no conjunto");
+        }
+        if (pred == nullptr) {
+            throw std::runtime_error("Não existe antecessor");
+        }
+        return pred->data;
+    }
+
+    /**
+     * @brief Método que visita em ordem, sobre um único snapshot, os elementos em [lo, hi]
+     *
+     * @param lo Limite inferior
+     * @param hi Limite superior
+     * @param visit Função chamada com cada elemento do intervalo
+     */
+    template <typename Visitor>
+    void for_each_in_range(const T& lo, const T& hi, Visitor visit) const {
+        EpochDomain::Guard guard;
+        const Node* stack[96];
+        int top = 0;
+        const Node* p = load_root();
+        while (p != nullptr || top > 0) {
+            while (p != nullptr) {  // desce a esquerda so enquanto pode haver chaves >= lo
+                if (compare(p->data, lo) < 0) {
+                    p = p->right;
+                } else {
+                    stack[top++] = p;
+                    p = p->left;
+                }
+            }
+            if (top == 0) {
+                break;
+            }
+            p = stack[--top];
+            if (compare(hi, p->data) < 0) {
+                break;
+            }
+            visit(p->data);
+            p = p->right;
+        }
+    }
+};
+
+#endif  // CONCURRENTAVL_H
@@ -0,0 +1,373 @@
+/**
+ * @file FrozenAVL.h
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief Visão imutável de uma árvore AVL em layout de Eytzinger: os elementos ficam em um vetor
+ * na ordem de uma busca em largura (filhos de k em 2k e 2k + 1). A descida não segue ponteiros,
+ * não tem desvios dependentes da comparação e os níveis seguintes podem ser pré-carregados.
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#ifndef FROZENAVL_H
+#define FROZENAVL_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define FROZEN_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define FROZEN_PREFETCH(addr)
+#endif
+
+/**
+ * @brief Classe que representa um conjunto ordenado imutável em layout de Eytzinger
+ *
+ * @tparam T Tipo dos elementos
+ * @tparam Compare Comparador de três vias (o mesmo da AVL_Tree de origem)
+ */
+template <typename T, typename Compare>
+class Frozen_AVL_Tree {
+   private:
+    // A descida pré-carrega data[16k]: os 16 descendentes de k quatro níveis abaixo ficam
+    // contíguos e, com chaves de 4 bytes, ocupam uma única linha de cache
+    static constexpr std::size_t PREFETCH_AHEAD = 16;
+
+    std::vector<T> data{};  // elementos em ordem de Eytzinger; data[0] não é usado
+    std::size_t n{};        // quantidade de elementos
+    Compare compare{};      // comparador de tres vias das chaves
+
+    /**
+     * @brief Método privado que preenche a subárvore de índice k com os próximos elementos de uma
+     * sequência ordenada, em ordem simétrica
+     *
+     * @param it Iterador da sequência, avançado a cada elemento consumido
+     * @param k Índice da raiz da subárvore
+     */
+    template <typename It>
+    void _fill(It& it, std::size_t k) {
+        if (k > n) {
+            return;
+        }
+        _fill(it, 2 * k);
+        data[k] = *it;
+        ++it;
+        _fill(it, 2 * k + 1);
+    }
+
+    /**
+     * @brief Método privado que retorna a quantidade de bits 1 no fim de k
+     *
+     * @param k Índice
+     * @return Quantidade de bits 1 consecutivos a partir do bit menos significativo
+     */
+    static int _trailing_ones(std::size_t k) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(~static_cast<unsigned long long>(k));
+#else
+        int count = 0;
+        while (k & 1) {
+            k >>= 1;
+            count++;
+        }
+        return count;
+#endif
+    }
+
+    /**
+     * @brief Método privado que desfaz as últimas voltas de uma descida até sair da folha: a
+     * descida terminou em uma posição vazia, e a resposta é o último node onde ela virou à
+     * esquerda
+     *
+     * @param k Posição vazia onde a descida terminou
+     * @return Índice da resposta, ou 0 se a descida nunca virou à esquerda
+     */
+    static std::size_t _last_left_turn(std::size_t k) {
+        return k >> (_trailing_ones(k) + 1);
+    }
+
+    /**
+     * @brief Método privado que retorna o índice do primeiro elemento maior ou igual a key
+     *
+     * @param key Chave de referência
+     * @return Índice encontrado, ou 0 se todos os elementos forem menores
+     */
+    template <typename K>
+    std::size_t _lower_bound(const K& key) const {
+        std::size_t k = 1;
+        while (k <= n) {
+            FROZEN_PREFETCH(data.data() + PREFETCH_AHEAD * k);
+            k = 2 * k + (compare(data[k], key) < 0);
+        }
+        return _last_left_turn(k);
+    }
+
+    /**
+     * @brief Método privado que retorna o índice do primeiro elemento maior que key
+     *
+     * @param key Chave de referência
+     * @return Índice encontrado, ou 0 se nenhum elemento for maior
+     */
+    template <typename K>
+    std::size_t _upper_bound(const K& key) const {
+        std::size_t k = 1;
+        while (k <= n) {
+            FROZEN_PREFETCH(data.data() + PREFETCH_AHEAD * k);
+            k = 2 * k + (compare(key, data[k]) >= 0);
+        }
+        return _last_left_turn(k);
+    }
+
+    /**
+     * @brief Método privado que retorna o índice do próximo elemento na ordem
+     *
+     * @param k Índice de um elemento
+     * @return Índice do próximo, ou 0 se k é o maior
+     */
+    std::size_t _next(std::size_t k) const {
+        if (2 * k + 1 <= n) {
+            k = 2 * k + 1;
+            while (2 * k <= n) {
+                k = 2 * k;
+            }
+            return k;
+        }
+        return _last_left_turn(k);
+    }
+
+    /**
+     * @brief Método privado que retorna o índice do elemento anterior na ordem
+     *
+     * @param k Índice de um elemento
+     * @return Índice do anterior, ou 0 se k é o menor
+     */
+    std::size_t _prev(std::size_t k) const {
+        if (2 * k <= n) {
+            k = 2 * k;
+            while (2 * k + 1 <= n) {
+                k = 2 * k + 1;
+            }
+            return k;
+        }
+        return k >> (_trailing_ones(~k) + 1);  // sobe enquanto k é filho esquerdo
+    }
+
+    /**
+     * @brief Método privado que encontra o índice de key, que precisa estar no conjunto
+     *
+     * @param key Chave procurada
+     * @return Índice da chave
+     */
+    std::size_t _index_of(const T& key) const {
+        std::size_t k = _lower_bound(key);
+        if (k == 0 || compare(data[k], key) != 0) {
+            throw std::runtime_error("Elemento não está no conjunto");
+        }
+        return k;
+    }
+
+   public:
+    /**
+     * @brief Iterador que percorre os elementos em ordem crescente
+     *
+     */
+    class iterator {
+       private:
+        const Frozen_AVL_Tree* tree{};
+        std::size_t k{};  // índice atual; 0 é o fim
+
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        iterator() = default;
+        iterator(const Frozen_AVL_Tree* tree, std::size_t k) : tree(tree), k(k) {}
+
+        reference operator*() const {
+            return tree->data[k];
+        }
+
+        pointer operator->() const {
+            return &tree->data[k];
+        }
+
+        iterator& operator++() {
+            k = tree->_next(k);
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const iterator& other) const {
+            return k == other.k;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return k != other.k;
+        }
+    };
+
+    using const_iterator = iterator;
+
+    /**
+     * @brief Construtor padrão. Cria um conjunto congelado vazio.
+     *
+     */
+    Frozen_AVL_Tree() = default;
+
+    /**
+     * @brief Constrói o layout a partir de n elementos em ordem estritamente crescente
+     *
+     * @param first Início da sequência ordenada
+     * @param count Quantidade de elementos
+     * @param compare Comparador das chaves
+     */
+    template <typename It>
+    Frozen_AVL_Tree(It first, std::size_t count, const Compare& compare = Compare())
+        : data(count + 1), n(count), compare(compare) {
+        _fill(first, 1);
+    }
+
+    /**
+     * @brief Verifica se o conjunto contém key
+     *
+     * @param key Chave procurada
+     * @return true se contém, false caso contrário
+     */
+    template <typename K>
+    bool contains(const K& key) const {
+        std::size_t k = _lower_bound(key);
+        return k != 0 && compare(data[k], key) == 0;
+    }
+
+    /**
+     * @brief Retorna um iterador para o primeiro elemento maior ou igual a key
+     *
+     * @param key Chave de referência
+     * @return iterator
+     */
+    template <typename K>
+    iterator lower_bound(const K& key) const {
+        return iterator(this, _lower_bound(key));
+    }
+
+    /**
+     * @brief Retorna um iterador para o primeiro elemento maior que key
+     *
+     * @param key Chave de referência
+     * @return iterator
+     */
+    template <typename K>
+    iterator upper_bound(const K& key) const {
+        return iterator(this, _upper_bound(key));
+    }
+
+    /**
+     * @brief Retorna o sucessor de um elemento, com a mesma semântica da AVL_Tree
+     *
+     * @param key Elemento do conjunto
+     * @return Sucessor do elemento
+     */
+    const T& successor(const T& key) const {
+        std::size_t k = _next(_index_of(key));
+        if (k == 0) {
+            throw std::runtime_error("Não existe sucessor");
+        }
+        return data[k];
+    }
+
+    /**
+     * @brief Retorna o antecessor de um elemento, com a mesma semântica da AVL_Tree
+     *
+     * @param key Elemento do conjunto
+     * @return Antecessor do elemento
+     */
+    const T& predecessor(const T& key) const {
+        std::size_t k = _prev(_index_of(key));
+        if (k == 0) {
+            throw std::runtime_error("Não existe antecessor");
+        }
+        return data[k];
+    }
+
+    /**
+     * @brief Retorna o menor elemento
+     *
+     * @return Menor elemento
+     */
+    const T& minimum() const {
+        if (n == 0) {
+            throw std::runtime_error("Conjunto vazio");
+        }
+        return *begin();
+    }
+
+    /**
+     * @brief Retorna o maior elemento
+     *
+     * @return Maior elemento
+     */
+    const T& maximum() const {
+        if (n == 0) {
+            throw std::runtime_error("Conjunto vazio");
+        }
+        std::size_t k = 1;
+        while (2 * k + 1 <= n) {
+            k = 2 * k + 1;
+        }
+        return data[k];
+    }
+
+    /**
+     * @brief Retorna um iterador para o menor elemento
+     *
+     * @return iterator
+     */
+    iterator begin() const {
+        std::size_t k = (n > 0) ? 1 : 0;
+        while (k != 0 && 2 * k <= n) {
+            k = 2 * k;
+        }
+        return iterator(this, k);
+    }
+
+    /**
+     * @brief Retorna o iterador de fim da ordem
+     *
+     * @return iterator
+     */
+    iterator end() const {
+        return iterator(this, 0);
+    }
+
+    /**
+     * @brief Retorna a quantidade de elementos
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const {
+        return n;
+    }
+
+    /**
+     * @brief Verifica se o conjunto está vazio
+     *
+     * @return true se está vazio, false caso contrário
+     */
+    bool empty() const {
+        return n == 0;
+    }
+};
+
+#endif  // FROZENAVL_H
@@ -0,0 +1,461 @@
+/**
+ * @file IntervalAVL.h
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief TAD para representar uma árvore de intervalos. É uma árvore AVL ordenada pelo início dos
+ * intervalos em que cada node guarda também o maior fim da sua subárvore, o que permite descartar
+ * subárvores inteiras nas consultas de sobreposição.
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#ifndef INTERVALAVL_H
+#define INTERVALAVL_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "AVL.h"
+#include "NodePool.h"
+
+/**
+ * @brief Classe que representa uma árvore AVL de intervalos fechados [lo, hi]
+ *
+ * @tparam T Tipo das extremidades dos intervalos
+ * @tparam Compare Comparador de três vias das extremidades
+ */
+template <typename T, typename Compare = three_way>
+class Interval_AVL_Tree {
+   private:
+    struct Node {
+        T lo;            // início do intervalo (chave da árvore)
+        T hi;            // fim do intervalo
+        T max;           // maior fim da subárvore
+        Node* left{};    // ponteiro para o filho esquerdo
+        Node* right{};   // ponteiro para o filho direito
+        int height = 1;  // altura do node
+
+        Node(const T& lo, const T& hi) : lo(lo), hi(hi), max(hi) {}
+    };
+
+    Node* root{};           // raiz da arvore
+    NodePool<Node> pool{};  // blocos onde os nodes sao alocados
+    int count{};            // quantidade de intervalos
+    Compare compare{};      // comparador de tres vias das extremidades
+
+    /**
+     * @brief Método privado que retorna a altura de um node
+     *
+     * @param node
+     * @return int
+     */
+    static int height(Node* node) {
+        return (node != nullptr) ? node->height : 0;
+    }
+
+    /**
+     * @brief Método privado que retorna o maior de dois valores segundo o comparador
+     *
+     */
+    const T& larger(const T& a, const T& b) const {
+        return (compare(a, b) < 0) ? b : a;
+    }
+
+    /**
+     * @brief Método privado que recalcula a altura e o maior fim de um node a partir dos filhos
+     *
+     * @param node Node a ser atualizado
+     */
+    void update(Node* node) {
+        node->height = 1 + std::max(height(node->left), height(node->right));
+        node->max = node->hi;
+        if (node->left != nullptr) {
+            node->max = larger(node->max, node->left->max);
+        }
+        if (node->right != nullptr) {
+            node->max = larger(node->max, node->right->max);
+        }
+    }
+
+    /**
+     * @brief Método privado que realiza a rotação à direita em um node p. Só p e o filho que
+     * sobe mudam de subárvore, então só os dois têm o maior fim recalculado.
+     *
+     * @param p Node a ser rotacionado
+     * @return Ponteiro para a nova raiz da subárvore
+     */
+    Node* rightRotation(Node* p) {
+        Node* u = p->left;
+        p->left = u->right;
+        u->right = p;
+        update(p);
+        update(u);
+        return u;
+    }
+
+    /**
+     * @brief Método privado que realiza a rotação à esquerda em um node p
+     *
+     * @param p Node a ser rotacionado
+     * @return Ponteiro para a nova raiz da subárvore
+     */
+    Node* leftRotation(Node* p) {
+        Node* u = p->right;
+        p->right = u->left;
+        u->left = p;
+        update(p);
+        update(u);
+        return u;
+    }
+
+    /**
+     * @brief Método privado que atualiza um node e aplica a rotação necessária
+     *
+     * @param node Node a ser regulado
+     * @return Ponteiro para a nova raiz da subárvore
+     */
+    Node* fixup(Node* node) {
+        update(node);
+        int bal = height(node->right) - height(node->left);
+        if (bal < -1) {
+            if (height(node->left->right) > height(node->left->left)) {
+                node->left = leftRotation(node->left);
+            }
+            return rightRotation(node);
+        }
+        if (bal > 1) {
+            if (height(node->right->left) > height(node->right->right)) {
+                node->right = rightRotation(node->right);
+            }
+            return leftRotation(node);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Método privado que compara dois intervalos pelo início e, em empate, pelo fim
+     *
+     * @return Valor negativo, zero ou positivo
+     */
+    int cmp(const T& lo, const T& hi, const Node* node) const {
+        auto c = compare(lo, node->lo);
+        if (c == 0) {
+            c = compare(hi, node->hi);
+        }
+        return (c < 0) ? -1 : (c > 0);
+    }
+
+    /**
+     * @brief Método privado que adiciona um intervalo a uma subárvore
+     *
+     * @param p Raiz da subárvore
+     * @param lo Início do intervalo
+     * @param hi Fim do intervalo
+     * @param added Saída: true se o intervalo foi adicionado
+     * @return Nova raiz da subárvore
+     */
+    Node* _add(Node* p, const T& lo, const T& hi, bool& added) {
+        if (p == nullptr) {
+            added = true;
+            return pool.create(lo, hi);
+        }
+        int c = cmp(lo, hi, p);
+        if (c == 0) {  // intervalo ja existe
+            return p;
+        }
+        if (c < 0) {
+            p->left = _add(p->left, lo, hi, added);
+        } else {
+            p->right = _add(p->right, lo, hi, added);
+        }
+        return added ? fixup(p) : p;
+    }
+
+    /**
+     * @brief Método privado que tira o menor node de uma subárvore não vazia
+     *
+     * @param p Raiz da subárvore
+     * @param min Saída: o menor node, solto
+     * @return Nova raiz da subárvore
+     */
+    Node* _remove_min(Node* p, Node*& min) {
+        if (p->left == nullptr) {
+            min = p;
+            return p->right;
+        }
+        p->left = _remove_min(p->left, min);
+        return fixup(p);
+    }
+
+    /**
+     * @brief Método privado que remove um intervalo de uma subárvore
+     *
+     * @param p Raiz da subárvore
+     * @param lo Início do intervalo
+     * @param hi Fim do intervalo
+     * @param removed Saída: true se o intervalo foi removido
+     * @return Nova raiz da subárvore
+     */
+    Node* _remove(Node* p, const T& lo, const T& hi, bool& removed) {
+        if (p == nullptr) {  // intervalo nao encontrado
+            return p;
+        }
+        int c = cmp(lo, hi, p);
+        if (c < 0) {
+            p->left = _remove(p->left, lo, hi, removed);
+        } else if (c > 0) {
+            p->right = _remove(p->right, lo, hi, removed);
+        } else {
+            removed = true;
+            Node* l = p->left;
+            Node* r = p->right;
+            pool.destroy(p);
+            if (r == nullptr) {
+                return l;
+            }
+            Node* succ = nullptr;
+            r = _remove_min(r, succ);
+            succ->left = l;
+            succ->right = r;
+            return fixup(succ);
+        }
+        return removed ? fixup(p) : p;
+    }
+
+    /**
+     * @brief Método privado que visita em ordem os intervalos de uma subárvore que se sobrepõem a
+     * [lo, hi]. Subárvores cujo maior fim é menor que lo, e subárvores à direita de um node que
+     * começa depois de hi, não são visitadas. Cada intervalo encontrado pode custar uma descida
+     * inteira, então o custo é O(min(n, (k + 1) log n)) e não O(log n + k).
+     *
+     * @param node Raiz da subárvore
+     * @param lo Início da consulta
+     * @param hi Fim da consulta
+     * @param visit Função chamada com (início, fim) de cada intervalo
+     */
+    template <typename Visitor>
+    void _overlapping(Node* node, const T& lo, const T& hi, Visitor& visit) const {
+        if (node == nullptr || compare(node->max, lo) < 0) {
+            return;
+        }
+        _overlapping(node->left, lo, hi, visit);
+        if (compare(node->lo, hi) > 0) {
+            return;
+        }
+        if (compare(node->hi, lo) >= 0) {
+            visit(node->lo, node->hi);
+        }
+        _overlapping(node->right, lo, hi, visit);
+    }
+
+    /**
+     * @brief Método privado que visita em ordem os intervalos de uma subárvore
+     *
+     * @param node Raiz da subárvore
+     * @param visit Função chamada com (início, fim) de cada intervalo
+     */
+    template <typename Visitor>
+    void _for_each(Node* node, Visitor& visit) const {
+        if (node != nullptr) {
+            _for_each(node->left, visit);
+            visit(node->lo, node->hi);
+            _for_each(node->right, visit);
+        }
+    }
+
+    /**
+     * @brief Método privado que destrói todos os nodes de uma subárvore
+     *
+     * @param node Node raiz da subárvore
+     */
+    void _destroy(Node* node) {
+        if (node != nullptr) {
+            _destroy(node->left);
+            _destroy(node->right);
+            pool.destroy(node);
+        }
+    }
+
+   public:
+    /**
+     * @brief Construtor padrão. Cria uma árvore de intervalos vazia.
+     *
+     */
+    Interval_AVL_Tree() = default;
+
+    Interval_AVL_Tree(const Interval_AVL_Tree&) = delete;
+    Interval_AVL_Tree& operator=(const Interval_AVL_Tree&) = delete;
+
+    /**
+     * @brief Construtor de movimento. A árvore de origem fica vazia.
+     *
+     * @param other Árvore a ser movida
+     */
+    Interval_AVL_Tree(Interval_AVL_Tree&& other) noexcept {
+        swap(other);
+    }
+
+    /**
+     * @brief Atribuição por movimento. Os intervalos atuais são liberados.
+     *
+     * @param other Árvore a ser movida
+     * @return Referência para esta árvore
+     */
+    Interval_AVL_Tree& operator=(Interval_AVL_Tree&& other) noexcept {
+        if (this != &other) {
+            clear();
+            swap(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destrutor. Libera todos os nodes.
+     *
+     */
+    ~Interval_AVL_Tree() {
+        clear();
+    }
+
+    /**
+     * @brief Metodo que adiciona o intervalo fechado [lo, hi]
+     *
+     * @param lo Início do intervalo
+     * @param hi Fim do intervalo
+     * @return true se o intervalo foi adicionado, false se já existia
+     */
+    bool add(const T& lo, const T& hi) {
+        if (compare(hi, lo) < 0) {
+            throw std::invalid_argument("Intervalo inválido");
+        }
+        bool added = false;
+        root = _add(root, lo, hi, added);
+        count += added;
+        return added;
+    }
+
+    /**
+     * @brief Metodo que remove o intervalo [lo, hi]
+     *
+     * @param lo Início do intervalo
+     * @param hi Fim do intervalo
+     * @return true se o intervalo foi removido, false se não estava na árvore
+     */
+    bool remove(const T& lo, const T& hi) {
+        bool removed = false;
+        root = _remove(root, lo, hi, removed);
+        count -= removed;
+        return removed;
+    }
+
+    /**
+     * @brief Método que verifica se algum intervalo contém point, em O(log n): desce pelo filho
+     * esquerdo sempre que o maior fim dele alcança point, senão pelo direito
+     *
+     * @param point Ponto consultado
+     * @return true se algum intervalo contém point, false caso contrário
+     */
+    bool overlaps(const T& point) const {
+        Node* p = root;
+        while (p != nullptr) {
+            if (compare(p->lo, point) <= 0 && compare(point, p->hi) <= 0) {
+                return true;
+            }
+            if (p->left != nullptr && compare(p->left->max, point) >= 0) {
+                p = p->left;
+            } else {
+                p = p->right;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Método que visita em ordem de início todos os intervalos que se sobrepõem a [lo, hi],
+     * em O(min(n, (k + 1) log n)) para k intervalos encontrados: a poda pelo maior fim garante
+     * O(log n) por intervalo encontrado, mas não o limite O(log n + k) das estruturas com lista
+     * ordenada por fim em cada node
+     *
+     * @param lo Início da consulta
+     * @param hi Fim da consulta
+     * @param visit Função chamada com (início, fim) de cada intervalo
+     */
+    template <typename Visitor>
+    void overlapping(const T& lo, const T& hi, Visitor visit) const {
+        _overlapping(root, lo, hi, visit);
+    }
+
+    /**
+     * @brief Método que visita em ordem todos os intervalos
+     *
+     * @param visit Função chamada com (início, fim) de cada intervalo
+     */
+    template <typename Visitor>
+    void for_each(Visitor visit) const {
+        _for_each(root, visit);
+    }
+
+    /**
+     * @brief Método que verifica se o intervalo [lo, hi] está na árvore
+     *
+     * @param lo Início do intervalo
+     * @param hi Fim do intervalo
+     * @return true se está, false caso contrário
+     */
+    bool contains(const T& lo, const T& hi) const {
+        Node* p = root;
+        while (p != nullptr) {
+            int c = cmp(lo, hi, p);
+            if (c == 0) {
+                return true;
+            }
+            p = (c < 0) ? p->left : p->right;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Método que retorna a quantidade de intervalos
+     *
+     * @return int
+     */
+    int size() const {
+        return count;
+    }
+
+    /**
+     * @brief Método que verifica se a árvore está vazia
+     *
+     * @return true se está vazia, false caso contrário
+     */
+    bool empty() const {
+        return count == 0;
+    }
+
+    /**
+     * @brief Método que remove todos os intervalos
+     *
+     */
+    void clear() {
+        _destroy(root);
+        pool.release();
+        root = nullptr;
+        count = 0;
+    }
+
+    /**
+     * @brief Método que troca o conteúdo de duas árvores de intervalos
+     *
+     * @param other Árvore a ser trocada
+     */
+    void swap(Interval_AVL_Tree& other) noexcept {
+        std::swap(root, other.root);
+        pool.swap(other.pool);
+        std::swap(count, other.count);
+        std::swap(compare, other.compare);
+    }
+};
+
+#endif  // INTERVALAVL_H
@@ -0,0 +1,334 @@
+/**
+ * @file LazyAVL.h
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief TAD para representar uma árvore AVL com remoção preguiçosa. Remover só marca o node como
+ * apagado (lápide), com o custo de uma busca; quando as lápides passam de uma fração da árvore,
+ * ela é reconstruída em tempo linear só com os elementos vivos, opcionalmente em outra thread.
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#ifndef LAZYAVL_H
+#define LAZYAVL_H
+
+#include <chrono>
+#include <future>
+#include <utility>
+#include <vector>
+
+#include "AVL.h"
+#include "Map.h"
+
+/**
+ * @brief Classe que representa uma árvore AVL com remoção por lápides e reconstrução periódica
+ *
+ * @tparam T Tipo de dado a ser armazenado na árvore
+ * @tparam Compare Comparador de três vias das chaves
+ */
+template <typename T, typename Compare = three_way>
+class Lazy_AVL_Tree {
+   private:
+    static constexpr int MIN_REBUILD_SIZE = 64;  // arvores menores nunca sao reconstruidas
+
+    /**
+     * @brief Elemento da árvore. A lápide é mutable para ser marcada sem tirar o node da árvore.
+     *
+     */
+    struct Entry {
+        T key;                      // chave do elemento
+        mutable bool dead = false;  // true se o elemento foi removido
+
+        explicit Entry(const T& key) : key(key) {}
+    };
+
+    /**
+     * @brief Comparador que olha apenas as chaves, transparente para consultas com T
+     *
+     */
+    struct KeyCompare {
+        using is_transparent = void;
+
+        Compare compare{};
+
+        auto operator()(const Entry& a, const Entry& b) const {
+            return compare(a.key, b.key);
+        }
+
+        auto operator()(const T& a, const Entry& b) const {
+            return compare(a, b.key);
+        }
+
+        auto operator()(const Entry& a, const T& b) const {
+            return compare(a.key, b);
+        }
+    };
+
+    using Tree = AVL_Tree<Entry, KeyCompare>;
+
+    Tree tree{};                          // elementos vivos e lapides
+    int dead{};                           // quantidade de lapides em tree
+    int live{};                           // quantidade de elementos vivos
+    double max_dead_fraction{};           // fracao de lapides que dispara a reconstrucao
+    bool background{};                    // true para reconstruir em outra thread
+    AVL_Map<T, bool, Compare> pending{};  // alteracoes feitas durante a reconstrucao (true = inserido)
+    std::future<Tree> rebuilding{};       // reconstrucao em andamento; declarada por ultimo para ser
+                                          // destruida (e esperada) antes de tree
+
+    /**
+     * @brief Método privado que monta uma nova árvore só com os elementos vivos de source, em
+     * tempo linear. Só lê source, então pode rodar em outra thread enquanto ninguém a altera.
+     *
+     * @param source Árvore de origem
+     * @return Árvore sem lápides
+     */
+    static Tree _compact(const Tree& source) {
+        std::vector<Entry> alive;
+        alive.reserve(source.size());
+        for (const Entry& e : source) {
+            if (!e.dead) {
+                alive.push_back(e);
+            }
+        }
+        return Tree::from_sorted(alive.begin(), alive.end());
+    }
+
+    /**
+     * @brief Método privado que verifica se há uma reconstrução em andamento
+     *
+     */
+    bool _rebuilding() const {
+        return rebuilding.valid();
+    }
+
+    /**
+     * @brief Método privado que troca a árvore pela reconstruída e reaplica sobre ela as
+     * operações guardadas durante a reconstrução
+     *
+     */
+    void _finish_rebuild() {
+        tree = rebuilding.get();
+        dead = 0;
+        for (const auto& op : pending) {
+            if (op.value) {
+                _insert(op.key);
+            } else {
+                _erase(op.key);
+            }
+        }
+        pending.clear();
+    }
+
+    /**
+     * @brief Método privado que conclui a reconstrução em segundo plano se ela já terminou
+     *
+     */
+    void _poll() {
+        if (_rebuilding() && rebuilding.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            _finish_rebuild();
+        }
+    }
+
+    /**
+     * @brief Método privado que dispara a reconstrução quando as lápides passam do limite
+     *
+     */
+    void _maybe_rebuild() {
+        if (_rebuilding() || tree.size() < MIN_REBUILD_SIZE || dead <= max_dead_fraction * tree.size()) {
+            return;
+        }
+        if (background) {
+            const Tree* source = &tree;
+            rebuilding = std::async(std::launch::async, [source] { return _compact(*source); });
+        } else {
+            tree = _compact(tree);
+            dead = 0;
+        }
+    }
+
+    /**
+     * @brief Método privado que insere direto na árvore, revivendo uma lápide se houver
+     *
+     * @param key Chave a ser inserida
+     * @return true se a chave não estava viva
+     */
+    bool _insert(const T& key) {
+        auto range = tree.equal_range(key);
+        if (range.first != range.second) {
+            if (!range.first->dead) {
+                return false;
+            }
+            range.first->dead = false;
+            dead--;
+            return true;
+        }
+        tree.add_hint(range.second, Entry(key));
+        return true;
+    }
+
+    /**
+     * @brief Método privado que marca uma lápide direto na árvore
+     *
+     * @param key Chave a ser removida
+     * @return true se a chave estava viva
+     */
+    bool _erase(const T& key) {
+        auto it = tree.find(key);
+        if (it == tree.end() || it->dead) {
+            return false;
+        }
+        it->dead = true;
+        dead++;
+        return true;
+    }
+
+    /**
+     * @brief Método privado que consulta a árvore, ignorando lápides
+     *
+     * @param key Chave procurada
+     * @return true se a chave está viva na árvore
+     */
+    bool _tree_contains(const T& key) const {
+        auto it = tree.find(key);
+        return it != tree.end() && !it->dead;
+    }
+
+   public:
+    /**
+     * @brief Construtor da árvore
+     *
+     * @param max_dead_fraction Fração de lápides (sobre o total de nodes) a partir da qual a
+     * árvore é reconstruída
+     * @param background true para reconstruir em outra thread; enquanto isso, as alterações são
+     * guardadas à parte e reaplicadas quando a nova árvore fica pronta
+     */
+    explicit Lazy_AVL_Tree(double max_dead_fraction = 0.25, bool background = false)
+        : max_dead_fraction(max_dead_fraction), background(background) {}
+
+    Lazy_AVL_Tree(const Lazy_AVL_Tree&) = delete;
+    Lazy_AVL_Tree& operator=(const Lazy_AVL_Tree&) = delete;
+
+    /**
+     * @brief Metodo que adiciona um elemento. Uma lápide com a mesma chave é revivida no lugar.
+     *
+     * @param key Chave a ser adicionada
+     * @return true se o elemento foi adicionado, false se já existia
+     */
+    bool add(const T& key) {
+        _poll();
+        if (_rebuilding()) {
+            if (contains(key)) {
+                return false;
+            }
+            pending.insert_or_assign(key, true);
+        } else if (!_insert(key)) {
+            return false;
+        }
+        live++;
+        return true;
+    }
+
+    /**
+     * @brief Metodo que remove um elemento marcando uma lápide, com o custo de uma busca. Pode
+     * disparar a reconstrução da árvore.
+     *
+     * @param key Chave a ser removida
+     * @return true se o elemento foi removido, false se não estava na árvore
+     */
+    bool remove(const T& key) {
+        _poll();
+        if (_rebuilding()) {
+            if (!contains(key)) {
+                return false;
+            }
+            pending.insert_or_assign(key, false);
+        } else if (!_erase(key)) {
+            return false;
+        }
+        live--;
+        _maybe_rebuild();
+        return true;
+    }
+
+    /**
+     * @brief Metodo que verifica se a chave está na árvore, ignorando lápides
+     *
+     * @param key Chave procurada
+     * @return true se contém, false caso contrário
+     */
+    bool contains(const T& key) const {
+        if (_rebuilding()) {
+            auto op = pending.find(key);
+            if (op != pending.end()) {
+                return op->value;
+            }
+        }
+        return _tree_contains(key);
+    }
+
+    /**
+     * @brief Metodo que espera a reconstrução em andamento, se houver, e aplica as alterações
+     * guardadas
+     *
+     */
+    void flush() {
+        if (_rebuilding()) {
+            _finish_rebuild();
+        }
+    }
+
+    /**
+     * @brief Metodo que visita em ordem os elementos vivos
+     *
+     * @param visit Função chamada com cada elemento
+     */
+    template <typename Visitor>
+    void for_each(Visitor visit) {
+        flush();
+        for (const Entry& e : tree) {
+            if (!e.dead) {
+                visit(e.key);
+            }
+        }
+    }
+
+    /**
+     * @brief Metodo que retorna a quantidade de elementos vivos
+     *
+     * @return int
+     */
+    int size() const {
+        return live;
+    }
+
+    /**
+     * @brief Metodo que verifica se não há elementos vivos
+     *
+     * @return true se está vazia, false caso contrário
+     */
+    bool empty() const {
+        return live == 0;
+    }
+
+    /**
+     * @brief Metodo que retorna a quantidade de lápides ainda guardadas na árvore
+     *
+     * @return int
+     */
+    int tombstones() const {
+        return dead;
+    }
+
+    /**
+     * @brief Metodo que remove todos os elementos
+     *
+     */
+    void clear() {
+        flush();
+        tree.clear();
+        dead = live = 0;
+    }
+};
+
+#endif  // LAZYAVL_H
@@ -0,0 +1,296 @@
+/**
+ * @file Map.h
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief TAD para representar um mapa ordenado de chaves para valores. O mapa é uma AVL_Tree de
+ * pares (chave, valor) ordenada só pela chave; o valor é atualizado no próprio node.
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#ifndef MAP_H
+#define MAP_H
+
+#include <stdexcept>
+#include <utility>
+
+#include "AVL.h"
+
+/**
+ * @brief Classe que representa um mapa ordenado implementado com uma árvore AVL
+ *
+ * @tparam K Tipo da chave
+ * @tparam V Tipo do valor
+ * @tparam Compare Comparador de três vias das chaves
+ */
+template <typename K, typename V, typename Compare = three_way>
+class AVL_Map {
+   public:
+    /**
+     * @brief Par armazenado em cada node. A chave é constante para a árvore (os iteradores só
+     * dão acesso const), mas o valor é mutable e pode ser alterado sem tirar o par da árvore.
+     *
+     */
+    struct Entry {
+        K key;            // chave do par
+        mutable V value;  // valor associado à chave
+
+        template <typename KK, typename... Args>
+        explicit Entry(KK&& key, Args&&... args) : key(std::forward<KK>(key)), value(std::forward<Args>(args)...) {}
+    };
+
+   private:
+    /**
+     * @brief Comparador que olha apenas as chaves. É transparente, então a árvore pode ser
+     * consultada direto com um K, sem montar um Entry.
+     *
+     */
+    struct KeyCompare {
+        using is_transparent = void;
+
+        Compare compare{};
+
+        auto operator()(const Entry& a, const Entry& b) const {
+            return compare(a.key, b.key);
+        }
+
+        template <typename A>
+        auto operator()(const A& a, const Entry& b) const {
+            return compare(a, b.key);
+        }
+
+        template <typename B>
+        auto operator()(const Entry& a, const B& b) const {
+            return compare(a.key, b);
+        }
+    };
+
+    using Tree = AVL_Tree<Entry, KeyCompare>;
+
+    Tree tree{};  // árvore com os pares ordenados pela chave
+
+    /**
+     * @brief Método privado que procura a chave e, se ela não existir, insere o par construído a
+     * partir de key e args usando como dica o sucessor encontrado pela descida
+     *
+     * @param key Chave procurada
+     * @param args Argumentos do construtor do valor, usados só se a chave não existir
+     * @return Par (iterador para o par da chave, true se foi inserido)
+     */
+    template <typename KK, typename... Args>
+    std::pair<typename Tree::iterator, bool> _try_emplace(KK&& key, Args&&... args) {
+        auto range = tree.equal_range(key);
+        if (range.first != range.second) {
+            return {range.first, false};
+        }
+        return {tree.add_hint(range.second, Entry(std::forward<KK>(key), std::forward<Args>(args)...)), true};
+    }
+
+   public:
+    using iterator = typename Tree::iterator;
+    using const_iterator = iterator;
+
+    /**
+     * @brief Construtor padrão. Cria um mapa vazio.
+     *
+     */
+    AVL_Map() = default;
+
+    /**
+     * @brief Retorna o valor associado a key, inserindo um valor padrão se a chave não existir
+     *
+     * @param key Chave procurada
+     * @return V& referência para o valor, que pode ser alterado no lugar
+     */
+    V& operator[](const K& key) {
+        return _try_emplace(key).first->value;
+    }
+
+    /**
+     * @brief Versão de operator[] que move a chave quando ela precisa ser inserida
+     *
+     * @param key Chave procurada
+     * @return V& referência para o valor
+     */
+    V& operator[](K&& key) {
+        return _try_emplace(std::move(key)).first->value;
+    }
+
+    /**
+     * @brief Retorna o valor associado a key
+     *
+     * @param key Chave procurada
+     * @return V& referência para o valor
+     */
+    V& at(const K& key) {
+        auto it = tree.find(key);
+        if (it == tree.end()) {
+            throw std::runtime_error("Chave não está no mapa");
+        }
+        return it->value;
+    }
+
+    /**
+     * @brief Versão const de at
+     *
+     * @param key Chave procurada
+     * @return const V& referência para o valor
+     */
+    const V& at(const K& key) const {
+        auto it = tree.find(key);
+        if (it == tree.end()) {
+            throw std::runtime_error("Chave não está no mapa");
+        }
+        return it->value;
+    }
+
+    /**
+     * @brief Insere o par (key, V(args...)) se a chave não existir. Se existir, nada é feito e os
+     * argumentos não são usados.
+     *
+     * @param key Chave do par
+     * @param args Argumentos do construtor do valor
+     * @return std::pair<iterator, bool> iterador para o par da chave e true se foi inserido
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+        return _try_emplace(key, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Versão de try_emplace que move a chave quando ela precisa ser inserida
+     *
+     * @param key Chave do par
+     * @param args Argumentos do construtor do valor
+     * @return std::pair<iterator, bool> iterador para o par da chave e true se foi inserido
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        return _try_emplace(std::move(key), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Insere o par (key, value) ou, se a chave já existir, atribui value ao valor atual
+     * no próprio node
+     *
+     * @param key Chave do par
+     * @param value Novo valor
+     * @return std::pair<iterator, bool> iterador para o par da chave e true se foi inserido
+     */
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const K& key, M&& value) {
+        auto result = _try_emplace(key, std::forward<M>(value));
+        if (!result.second) {
+            result.first->value = std::forward<M>(value);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Procura uma chave. O valor do par apontado pode ser alterado pelo iterador
+     * (it->value), pois é mutable.
+     *
+     * @param key Chave procurada
+     * @return iterator iterador para o par, ou end() se a chave não existir
+     */
+    iterator find(const K& key) const {
+        return tree.find(key);
+    }
+
+    /**
+     * @brief Remove o par com a chave key. Só referências e iteradores para esse par deixam de
+     * valer; os das outras chaves continuam válidos.
+     *
+     * @param key Chave do par
+     * @return true se o par foi removido, false se a chave não existia
+     */
+    bool erase(const K& key) {
+        return tree.remove(key);
+    }
+
+    /**
+     * @brief Verifica se a chave está no mapa
+     *
+     * @param key Chave procurada
+     * @return true se está, false caso contrário
+     */
+    bool contains(const K& key) const {
+        return tree.contains(key);
+    }
+
+    /**
+     * @brief Retorna um iterador para o primeiro par com chave maior ou igual a key
+     *
+     * @param key Chave de referência
+     * @return iterator
+     */
+    iterator lower_bound(const K& key) const {
+        return tree.lower_bound(key);
+    }
+
+    /**
+     * @brief Retorna um iterador para o primeiro par com chave maior que key
+     *
+     * @param key Chave de referência
+     * @return iterator
+     */
+    iterator upper_bound(const K& key) const {
+        return tree.upper_bound(key);
+    }
+
+    /**
+     * @brief Retorna um iterador para o par de menor chave
+     *
+     * @return iterator
+     */
+    iterator begin() const {
+        return tree.begin();
+    }
+
+    /**
+     * @brief Retorna o iterador de fim da ordem
+     *
+     * @return iterator
+     */
+    iterator end() const {
+        return tree.end();
+    }
+
+    /**
+     * @brief Retorna a quantidade de pares do mapa
+     *
+     * @return int
+     */
+    int size() const {
+        return tree.size();
+    }
+
+    /**
+     * @brief Verifica se o mapa está vazio
+     *
+     * @return true se está vazio, false caso contrário
+     */
+    bool empty() const {
+        return tree.size() == 0;
+    }
+
+    /**
+     * @brief Remove todos os pares do mapa
+     *
+     */
+    void clear() {
+        tree.clear();
+    }
+
+    /**
+     * @brief Troca o conteúdo de dois mapas
+     *
+     * @param other Mapa a ser trocado
+     */
+    void swap(AVL_Map& other) noexcept {
+        tree.swap(other.tree);
+    }
+};
+
+#endif  // MAP_H
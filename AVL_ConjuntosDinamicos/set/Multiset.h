@@ -0,0 +1,291 @@
+/**
+ * @file Multiset.h
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief TAD para representar um multiconjunto. Cada chave distinta ocupa um único node com a sua
+ * quantidade de cópias, então a memória é proporcional às chaves distintas (d) e as operações
+ * custam O(log d).
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#ifndef MULTISET_H
+#define MULTISET_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "Map.h"
+
+/**
+ * @brief Classe que representa um multiconjunto implementado com um AVL_Map de chave para
+ * quantidade
+ *
+ * @tparam T Tipo dos elementos
+ * @tparam Compare Comparador de três vias dos elementos
+ */
+template <typename T, typename Compare = three_way>
+class AVL_Multiset {
+   private:
+    using Counts = AVL_Map<T, std::size_t, Compare>;
+
+    Counts counts{};      // quantidade de cópias de cada chave distinta
+    std::size_t total{};  // quantidade de elementos, contando as repetições
+
+   public:
+    /**
+     * @brief Vista de uma chave distinta: a chave e a sua quantidade de cópias. É devolvida por
+     * valor, então alterar value não muda o multiconjunto.
+     *
+     */
+    struct Item {
+        const T& key;       // chave
+        std::size_t value;  // quantidade de cópias
+    };
+
+    /**
+     * @brief Iterador que percorre as chaves distintas em ordem: it->key e it->value. Não dá
+     * acesso ao valor mutable do mapa, para que a quantidade só mude pelos métodos do
+     * multiconjunto e size() continue igual à soma das quantidades.
+     *
+     */
+    class iterator {
+       private:
+        typename Counts::iterator it{};  // posição no mapa de quantidades
+
+        friend class AVL_Multiset;
+
+        explicit iterator(typename Counts::iterator it) : it(it) {}
+
+        /**
+         * @brief Guarda o Item devolvido por operator->, que não tem endereço próprio
+         *
+         */
+        struct Arrow {
+            Item item;
+
+            const Item* operator->() const {
+                return &item;
+            }
+        };
+
+       public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Item;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Arrow;
+        using reference = Item;
+
+        iterator() = default;
+
+        reference operator*() const {
+            return {it->key, it->value};
+        }
+
+        pointer operator->() const {
+            return {**this};
+        }
+
+        iterator& operator++() {
+            ++it;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator old = *this;
+            ++it;
+            return old;
+        }
+
+        iterator& operator--() {
+            --it;
+            return *this;
+        }
+
+        iterator operator--(int) {
+            iterator old = *this;
+            --it;
+            return old;
+        }
+
+        bool operator==(const iterator& other) const {
+            return it == other.it;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return it != other.it;
+        }
+    };
+
+    using const_iterator = iterator;
+
+    /**
+     * @brief Construtor padrão. Cria um multiconjunto vazio.
+     *
+     */
+    AVL_Multiset() = default;
+
+    /**
+     * @brief Insere n cópias de key. Se a chave já existe, só a quantidade do node é alterada.
+     *
+     * @param key Elemento a ser inserido
+     * @param n Quantidade de cópias
+     * @return std::size_t quantidade de cópias de key após a inserção
+     */
+    std::size_t insert(const T& key, std::size_t n = 1) {
+        if (n == 0) {
+            return count(key);
+        }
+        total += n;
+        return counts[key] += n;
+    }
+
+    /**
+     * @brief Retorna quantas cópias de key existem
+     *
+     * @param key Elemento procurado
+     * @return std::size_t quantidade de cópias (0 se não existe)
+     */
+    std::size_t count(const T& key) const {
+        auto it = counts.find(key);
+        return (it != counts.end()) ? it->value : 0;
+    }
+
+    /**
+     * @brief Remove uma cópia de key. O node só sai da árvore quando a última cópia é removida.
+     *
+     * @param key Elemento a ser removido
+     * @return true se havia uma cópia, false caso contrário
+     */
+    bool erase_one(const T& key) {
+        auto it = counts.find(key);
+        if (it == counts.end()) {
+            return false;
+        }
+        total--;
+        if (--it->value == 0) {
+            counts.erase(key);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Remove todas as cópias de key
+     *
+     * @param key Elemento a ser removido
+     * @return std::size_t quantidade de cópias removidas
+     */
+    std::size_t erase_all(const T& key) {
+        auto it = counts.find(key);
+        if (it == counts.end()) {
+            return 0;
+        }
+        std::size_t n = it->value;
+        total -= n;
+        counts.erase(key);
+        return n;
+    }
+
+    /**
+     * @brief Verifica se há ao menos uma cópia de key
+     *
+     * @param key Elemento procurado
+     * @return true se há, false caso contrário
+     */
+    bool contains(const T& key) const {
+        return counts.contains(key);
+    }
+
+    /**
+     * @brief Retorna o menor elemento
+     *
+     * @return const T& menor elemento
+     */
+    const T& minimum() const {
+        if (counts.empty()) {
+            throw std::runtime_error("Multiconjunto vazio");
+        }
+        return counts.begin()->key;
+    }
+
+    /**
+     * @brief Retorna o maior elemento
+     *
+     * @return const T& maior elemento
+     */
+    const T& maximum() const {
+        if (counts.empty()) {
+            throw std::runtime_error("Multiconjunto vazio");
+        }
+        return (--counts.end())->key;
+    }
+
+    /**
+     * @brief Retorna a quantidade de elementos, contando as repetições
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const {
+        return total;
+    }
+
+    /**
+     * @brief Retorna a quantidade de elementos distintos (nodes da árvore)
+     *
+     * @return std::size_t
+     */
+    std::size_t distinct() const {
+        return counts.size();
+    }
+
+    /**
+     * @brief Verifica se o multiconjunto está vazio
+     *
+     * @return true se está vazio, false caso contrário
+     */
+    bool empty() const {
+        return total == 0;
+    }
+
+    /**
+     * @brief Remove todos os elementos
+     *
+     */
+    void clear() {
+        counts.clear();
+        total = 0;
+    }
+
+    /**
+     * @brief Troca o conteúdo de dois multiconjuntos
+     *
+     * @param other Multiconjunto a ser trocado
+     */
+    void swap(AVL_Multiset& other) noexcept {
+        counts.swap(other.counts);
+        std::swap(total, other.total);
+    }
+
+    /**
+     * @brief Retorna um iterador para a menor chave distinta
+     *
+     * @return iterator
+     */
+    iterator begin() const {
+        return iterator(counts.begin());
+    }
+
+    /**
+     * @brief Retorna o iterador de fim da ordem
+     *
+     * @return iterator
+     */
+    iterator end() const {
+        return iterator(counts.end());
+    }
+};
+
+#endif  // MULTISET_H
@@ -0,0 +1,237 @@
+/**
+ * @file NodePool.h
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief Alocador de nodes em blocos (slabs) com lista livre. Os nodes ficam contíguos na memória,
+ * são reciclados em O(1) e o pool inteiro é liberado bloco a bloco. O primeiro bloco é pequeno e
+ * cada novo bloco tem o dobro do anterior, até SlabSize, para que estruturas com poucos elementos
+ * não paguem por um bloco inteiro.
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Classe que representa um pool de objetos do tipo T alocados em blocos
+ *
+ * @tparam T Tipo de objeto alocado pelo pool
+ * @tparam SlabSize Quantidade máxima de objetos por bloco
+ */
+template <typename T, std::size_t SlabSize = 512>
+class NodePool {
+   private:
+    /**
+     * @brief Posição de um bloco. Enquanto livre, guarda o ponteiro para a próxima posição livre.
+     *
+     */
+    union Slot {
+        Slot* next;                                   // próxima posição da lista livre
+        alignas(T) unsigned char storage[sizeof(T)];  // espaço para o objeto
+    };
+
+    static constexpr std::size_t FIRST_SLAB = (SlabSize < 8) ? SlabSize : 8;  // primeiro bloco
+
+    std::vector<Slot*> slabs{};         // blocos alocados
+    Slot* free_list{};                  // posições devolvidas e prontas para reuso
+    Slot* bump{};                       // próxima posição nunca usada do bloco atual
+    Slot* bump_end{};                   // fim do bloco atual
+    std::size_t next_slab{FIRST_SLAB};  // tamanho do próximo bloco alocado por take
+
+    /**
+     * @brief Método privado que aloca um novo bloco com n posições
+     *
+     * @param n Quantidade de posições do bloco
+     */
+    void new_slab(std::size_t n) {
+        slabs.reserve(slabs.size() + 1);
+        Slot* slab = new Slot[n];
+        slabs.push_back(slab);
+        bump = slab;
+        bump_end = slab + n;
+    }
+
+    /**
+     * @brief Método privado que passa as posições ainda não usadas do bloco atual para a lista
+     * livre, em ordem crescente de endereço
+     *
+     */
+    void retire_bump() {
+        while (bump_end != bump) {
+            --bump_end;
+            bump_end->next = free_list;
+            free_list = bump_end;
+        }
+        bump = bump_end = nullptr;
+    }
+
+    /**
+     * @brief Método privado que retorna uma posição livre, alocando um bloco se necessário. Os
+     * blocos dobram de tamanho a cada alocação, até SlabSize.
+     *
+     * @return Ponteiro para a posição
+     */
+    Slot* take() {
+        if (free_list != nullptr) {
+            Slot* s = free_list;
+            free_list = s->next;
+            return s;
+        }
+        if (bump == bump_end) {
+            new_slab(next_slab);
+            next_slab = (next_slab < SlabSize / 2) ? next_slab * 2 : SlabSize;
+        }
+        return bump++;
+    }
+
+   public:
+    /**
+     * @brief Construtor padrão. Não aloca memória até o primeiro create.
+     *
+     */
+    NodePool() = default;
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    /**
+     * @brief Construtor de movimento. O pool de origem fica vazio.
+     *
+     * @param other Pool a ser movido
+     */
+    NodePool(NodePool&& other) noexcept {
+        swap(other);
+    }
+
+    /**
+     * @brief Atribuição por movimento. Os blocos atuais são liberados.
+     *
+     * @param other Pool a ser movido
+     * @return Referência para este pool
+     */
+    NodePool& operator=(NodePool&& other) noexcept {
+        if (this != &other) {
+            release();
+            swap(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destrutor. Libera todos os blocos sem chamar destrutores dos objetos.
+     *
+     */
+    ~NodePool() {
+        release();
+    }
+
+    /**
+     * @brief Constrói um objeto em uma posição do pool
+     *
+     * @param args Argumentos repassados ao construtor de T
+     * @return Ponteiro para o objeto construído
+     */
+    template <typename... Args>
+    T* create(Args&&... args) {
+        Slot* s = take();
+        try {
+            return ::new (static_cast<void*>(s->storage)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            s->next = free_list;
+            free_list = s;
+            throw;
+        }
+    }
+
+    /**
+     * @brief Garante que os próximos n creates não alocam memória. Quando o bloco atual não tem
+     * espaço suficiente, as posições que sobraram nele vão para a lista livre (e são usadas
+     * primeiro) e um único bloco com o restante é alocado.
+     *
+     * @param n Quantidade de objetos que serão criados
+     */
+    void reserve(std::size_t n) {
+        std::size_t remaining = static_cast<std::size_t>(bump_end - bump);
+        if (remaining < n) {
+            retire_bump();
+            new_slab(n - remaining);
+        }
+    }
+
+    /**
+     * @brief Destrói um objeto e devolve sua posição à lista livre em O(1)
+     *
+     * @param p Objeto criado por este pool
+     */
+    void destroy(T* p) {
+        p->~T();
+        Slot* s = reinterpret_cast<Slot*>(p);
+        s->next = free_list;
+        free_list = s;
+    }
+
+    /**
+     * @brief Libera todos os blocos de uma vez. Os destrutores dos objetos vivos NÃO são chamados.
+     *
+     */
+    void release() {
+        for (Slot* slab : slabs) {
+            delete[] slab;
+        }
+        slabs.clear();
+        free_list = bump = bump_end = nullptr;
+        next_slab = FIRST_SLAB;
+    }
+
+    /**
+     * @brief Assume os blocos de outro pool, que fica vazio. Os objetos vivos de other passam a
+     * pertencer a este pool; as posições livres de other (inclusive o resto do seu bloco atual)
+     * entram na lista livre deste. Custa O(blocos + posições livres de other).
+     *
+     * @param other Pool a ser absorvido
+     */
+    void merge(NodePool& other) {
+        if (this == &other) {
+            return;
+        }
+        slabs.insert(slabs.end(), other.slabs.begin(), other.slabs.end());
+        other.slabs.clear();
+        for (Slot* s = other.bump; s != other.bump_end; ++s) {
+            s->next = free_list;
+            free_list = s;
+        }
+        while (other.free_list != nullptr) {
+            Slot* s = other.free_list;
+            other.free_list = s->next;
+            s->next = free_list;
+            free_list = s;
+        }
+        other.bump = other.bump_end = nullptr;
+        if (next_slab < other.next_slab) {
+            next_slab = other.next_slab;
+        }
+        other.next_slab = FIRST_SLAB;
+    }
+
+    /**
+     * @brief Troca o conteúdo de dois pools
+     *
+     * @param other Pool a ser trocado
+     */
+    void swap(NodePool& other) noexcept {
+        slabs.swap(other.slabs);
+        std::swap(free_list, other.free_list);
+        std::swap(bump, other.bump);
+        std::swap(bump_end, other.bump_end);
+        std::swap(next_slab, other.next_slab);
+    }
+};
+
+#endif  // NODEPOOL_H
@@ -0,0 +1,522 @@
+/**
+ * @file PersistentAVL.h
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief TAD para representar uma árvore AVL persistente. Inserções e remoções copiam apenas os
+ * O(log n) nodes do caminho até a raiz e compartilham o resto com as versões anteriores, então
+ * tirar uma cópia (snapshot) da árvore custa O(1).
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#ifndef PERSISTENTAVL_H
+#define PERSISTENTAVL_H
+
+#include <algorithm>
+#include <memory>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "AVL.h"
+
+/**
+ * @brief Classe que representa uma árvore AVL persistente (cópia de caminho). Os nodes nunca são
+ * alterados depois de criados e são liberados por contagem de referências quando nenhuma versão
+ * os usa mais. Cada objeto é uma versão: copiar o objeto tira um snapshot, e alterar a cópia não
+ * afeta o original.
+ *
+ * @tparam T Tipo de dado a ser armazenado na árvore
+ * @tparam Compare Comparador de três vias, como em AVL_Tree
+ */
+template <typename T, typename Compare = three_way>
+class Persistent_AVL_Tree {
+   private:
+    struct Node;
+    using Link = std::shared_ptr<const Node>;
+
+    struct Node {
+        T data;      // dado armazenado no node
+        Link left;   // filho esquerdo (compartilhado entre versoes)
+        Link right;  // filho direito (compartilhado entre versoes)
+        int height;  // altura do node
+        int size;    // quantidade de nodes na subarvore
+
+        /**
+         * @brief Construtor do Node. Altura e tamanho são calculados a partir dos filhos.
+         *
+         * @param data Dado a ser armazenado no node
+         * @param left Filho esquerdo
+         * @param right Filho direito
+         */
+        Node(const T& data, Link left, Link right)
+            : data(data), left(std::move(left)), right(std::move(right)) {
+            height = 1 + std::max(Persistent_AVL_Tree::height(this->left), Persistent_AVL_Tree::height(this->right));
+            size = 1 + Persistent_AVL_Tree::size(this->left) + Persistent_AVL_Tree::size(this->right);
+        }
+    };
+
+    Link root{};        // raiz desta versao
+    Compare compare{};  // comparador de tres vias das chaves
+
+    /**
+     * @brief Método privado que retorna a altura de um node
+     *
+     * @param node
+     * @return int
+     */
+    static int height(const Link& node) {
+        return (node != nullptr) ? node->height : 0;
+    }
+
+    /**
+     * @brief Método privado que retorna a quantidade de nodes da subárvore de um node
+     *
+     * @param node
+     * @return int
+     */
+    static int size(const Link& node) {
+        return (node != nullptr) ? node->size : 0;
+    }
+
+    /**
+     * @brief Método privado que cria um novo node com os filhos dados, aplicando a rotação
+     * necessária quando as alturas dos filhos diferem em 2. As rotações também criam nodes novos,
+     * pois nenhum node existente pode ser alterado.
+     *
+     * @param data Dado do node
+     * @param l Filho esquerdo
+     * @param r Filho direito
+     * @return Raiz da nova subárvore balanceada
+     */
+    static Link make_balanced(const T& data, const Link& l, const Link& r) {
+        if (height(l) > height(r) + 1) {
+            if (height(l->left) >= height(l->right)) {  // rotacao a direita
+                return std::make_shared<const Node>(l->data, l->left, std::make_shared<const Node>(data, l->right, r));
+            }
+            const Link& lr = l->right;  // rotacao dupla esquerda-direita
+            return std::make_shared<const Node>(lr->data, std::make_shared<const Node>(l->data, l->left, lr->left),
+                                                std::make_shared<const Node>(data, lr->right, r));
+        }
+        if (height(r) > height(l) + 1) {
+            if (height(r->right) >= height(r->left)) {  // rotacao a esquerda
+                return std::make_shared<const Node>(r->data, std::make_shared<const Node>(data, l, r->left), r->right);
+            }
+            const Link& rl = r->left;  // rotacao dupla direita-esquerda
+            return std::make_shared<const Node>(rl->data, std::make_shared<const Node>(data, l, rl->left),
+                                                std::make_shared<const Node>(r->data, rl->right, r->right));
+        }
+        return std::make_shared<const Node>(data, l, r);
+    }
+
+    /**
+     * @brief Método privado que adiciona um elemento, copiando os nodes do caminho
+     *
+     * @param p Raiz da subárvore
+     * @param data Dado a ser adicionado
+     * @param added Saída: true se o elemento foi adicionado
+     * @return Raiz da nova versão da subárvore (a própria p se nada mudou)
+     */
+    Link _add(const Link& p, const T& data, bool& added) {
+        if (p == nullptr) {  // subarvore vazia
+            added = true;
+            return std::make_shared<const Node>(data, nullptr, nullptr);
+        }
+        auto c = compare(data, p->data);
+        if (c == 0) {  // chave ja existe
+            return p;
+        }
+        if (c < 0) {
+            Link l = _add(p->left, data, added);
+            return added ? make_balanced(p->data, l, p->right) : p;
+        }
+        Link r = _add(p->right, data, added);
+        return added ? make_balanced(p->data, p->left, r) : p;
+    }
+
+    /**
+     * @brief Método privado que remove o menor elemento de uma subárvore não vazia
+     *
+     * @param p Raiz da subárvore
+     * @param min Saída: o elemento removido
+     * @return Raiz da nova versão da subárvore
+     */
+    Link _remove_min(const Link& p, T& min) {
+        if (p->left == nullptr) {
+            min = p->data;
+            return p->right;
+        }
+        Link l = _remove_min(p->left, min);
+        return make_balanced(p->data, l, p->right);
+    }
+
+    /**
+     * @brief Método privado que remove um elemento, copiando os nodes do caminho
+     *
+     * @param p Raiz da subárvore
+     * @param data Dado a ser removido
+     * @param removed Saída: true se o elemento foi removido
+     * @return Raiz da nova versão da subárvore (a própria p se nada mudou)
+     */
+    Link _remove(const Link& p, const T& data, bool& removed) {
+        if (p == nullptr) {  // node nao encontrado
+            return p;
+        }
+        auto c = compare(data, p->data);
+        if (c < 0) {
+            Link l = _remove(p->left, data, removed);
+            return removed ? make_balanced(p->data, l, p->right) : p;
+        }
+        if (c > 0) {
+            Link r = _remove(p->right, data, removed);
+            return removed ? make_balanced(p->data, p->left, r) : p;
+        }
+        removed = true;
+        if (p->left == nullptr) {
+            return p->right;
+        }
+        if (p->right == nullptr) {
+            return p->left;
+        }
+        T succ = p->data;
+        Link r = _remove_min(p->right, succ);
+        return make_balanced(succ, p->left, r);
+    }
+
+    /**
+     * @brief Método privado que visita em ordem os elementos de uma subárvore
+     *
+     * @param node Raiz da subárvore
+     * @param visit Função chamada com cada elemento
+     */
+    template <typename Visitor>
+    static void _for_each(const Node* node, Visitor& visit) {
+        if (node != nullptr) {
+            _for_each(node->left.get(), visit);
+            visit(node->data);
+            _for_each(node->right.get(), visit);
+        }
+    }
+
+    /**
+     * @brief Método privado que visita em ordem os elementos de uma subárvore que estão em [lo, hi]
+     *
+     * @param node Raiz da subárvore
+     * @param lo Limite inferior
+     * @param hi Limite superior
+     * @param visit Função chamada com cada elemento do intervalo
+     */
+    template <typename Visitor>
+    void _for_each_in_range(const Node* node, const T& lo, const T& hi, Visitor& visit) const {
+        if (node == nullptr) {
+            return;
+        }
+        auto c_lo = compare(lo, node->data);
+        auto c_hi = compare(node->data, hi);
+        if (c_lo < 0) {
+            _for_each_in_range(node->left.get(), lo, hi, visit);
+        }
+        if (c_lo <= 0 && c_hi <= 0) {
+            visit(node->data);
+        }
+        if (c_hi < 0) {
+            _for_each_in_range(node->right.get(), lo, hi, visit);
+        }
+    }
+
+   public:
+    /**
+     * @brief Iterador que percorre uma versão em ordem crescente. Os nodes não têm ponteiro para o
+     * pai, então o caminho até o node atual fica em uma pilha. O iterador guarda uma referência
+     * para a raiz da versão, que continua válida mesmo se a versão de origem for alterada ou
+     * destruída.
+     *
+     */
+    class iterator {
+       private:
+        Link root{};                      // mantem a versao percorrida viva
+        std::vector<const Node*> path{};  // ancestrais ainda não visitados; o topo é o atual
+
+        /**
+         * @brief Empilha node e todos os filhos esquerdos abaixo dele
+         *
+         */
+        void _push_left(const Node* node) {
+            for (; node != nullptr; node = node->left.get()) {
+                path.push_back(node);
+            }
+        }
+
+        friend class Persistent_AVL_Tree;
+
+        explicit iterator(const Link& root) : root(root) {
+            _push_left(root.get());
+        }
+
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        iterator() = default;
+
+        reference operator*() const {
+            return path.back()->data;
+        }
+
+        pointer operator->() const {
+            return &path.back()->data;
+        }
+
+        iterator& operator++() {
+            const Node* node = path.back();
+            path.pop_back();
+            _push_left(node->right.get());
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const iterator& other) const {
+            return (path.empty() ? nullptr : path.back()) == (other.path.empty() ? nullptr : other.path.back());
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    using const_iterator = iterator;
+
+    /**
+     * @brief Construtor padrão da classe Persistent_AVL_Tree. Cria uma versão vazia.
+     *
+     */
+    Persistent_AVL_Tree() = default;
+
+    /**
+     * @brief Método que retorna uma cópia desta versão em O(1). As duas versões compartilham
+     * todos os nodes e podem ser alteradas de forma independente depois.
+     *
+     * @return Snapshot da versão atual
+     */
+    Persistent_AVL_Tree snapshot() const {
+        return *this;
+    }
+
+    /**
+     * @brief Metodo para adicionar um elemento nesta versão. Versões anteriores não mudam.
+     *
+     * @param data
+     * @return true se o elemento foi adicionado, false se já existia
+     */
+    bool add(const T& data) {
+        bool added = false;
+        root = _add(root, data, added);
+        return added;
+    }
+
+    /**
+     * @brief Metodo para remover um elemento desta versão. Versões anteriores não mudam.
+     *
+     * @param data
+     * @return true se o elemento foi removido, false se não estava na árvore
+     */
+    bool remove(const T& data) {
+        bool removed = false;
+        root = _remove(root, data, removed);
+        return removed;
+    }
+
+    /**
+     * @brief Método que esvazia esta versão. Os nodes só são liberados quando nenhuma outra versão
+     * os usa.
+     *
+     */
+    void clear() {
+        root.reset();
+    }
+
+    /**
+     * @brief Método que troca duas versões em O(1)
+     *
+     * @param other Versão a ser trocada
+     */
+    void swap(Persistent_AVL_Tree& other) noexcept {
+        std::swap(root, other.root);
+        std::swap(compare, other.compare);
+    }
+
+    /**
+     * @brief Método que retorna a quantidade de elementos desta versão em O(1)
+     *
+     * @return Quantidade de elementos
+     */
+    int size() const {
+        return size(root);
+    }
+
+    /**
+     * @brief Método que verifica se esta versão está vazia
+     *
+     * @return true se está vazia, false caso contrário
+     */
+    bool empty() const {
+        return root == nullptr;
+    }
+
+    /**
+     * @brief Função pública que verifica se a versão contém a chave val
+     *
+     * @param val chave a ser verificada
+     * @return true se contém,
+     * @return false caso contrário
+     */
+    bool contains(const T& val) const {
+        const Node* p = root.get();
+        while (p != nullptr) {
+            auto c = compare(val, p->data);
+            if (c == 0) {
+                return true;
+            }
+            p = (c < 0) ? p->left.get() : p->right.get();
+        }
+        return false;
+    }
+
+    /**
+     * @brief Método que retorna o menor elemento da versão
+     *
+     * @return Valor do menor elemento
+     */
+    const T& minimum() const {
+        const Node* p = root.get();
+        while (p->left != nullptr) {
+            p = p->left.get();
+        }
+        return p->data;
+    }
+
+    /**
+     * @brief Método que retorna o maior elemento da versão
+     *
+     * @return Valor do maior elemento
+     */
+    const T& maximum() const {
+        const Node* p = root.get();
+        while (p->right != nullptr) {
+            p = p->right.get();
+        }
+        return p->data;
+    }
+
+    /**
+     * @brief Método que retorna o sucessor de um elemento
+     *
+     * @param key Elemento a ser verificado
+     * @return Sucessor do elemento
+     */
+    const T& successor(const T& key) const {
+        const Node* p = root.get();
+        const Node* sucessor = nullptr;
+        bool found = false;
+        while (p != nullptr) {
+            auto c = compare(key, p->data);
+            if (c < 0) {
+                sucessor = p;
+                p = p->left.get();
+            } else {
+                found = found || c == 0;
+                p = p->right.get();
+            }
+        }
+        if (!found) {
+            throw std::runtime_error("Elemento não está no conjunto");
+        }
+        if (sucessor == nullptr) {
+            throw std::runtime_error("Não existe sucessor");
+        }
+        return sucessor->data;
+    }
+
+    /**
+     * @brief Método que retorna o antecessor de um elemento
+     *
+     * @param key Elemento a ser verificado
+     * @return Antecessor do elemento
+     */
+    const T& predecessor(const T& key) const {
+        const Node* p = root.get();
+        const Node* pred = nullptr;
+        bool found = false;
+        while (p != nullptr) {
+            auto c = compare(key, p->data);
+            if (c > 0) {
+                pred = p;
+                p = p->right.get();
+            } else {
+                found = found || c == 0;
+                p = p->left.get();
+            }
+        }
+        if (!found) {
+            throw std::runtime_error("Elemento não está no conjunto");
+        }
+        if (pred == nullptr) {
+            throw std::runtime_error("Não existe antecessor");
+        }
+        return pred->data;
+    }
+
+    /**
+     * @brief Método que visita todos os elementos da versão em ordem crescente
+     *
+     * @param visit Função chamada com cada elemento
+     */
+    template <typename Visitor>
+    void for_each(Visitor visit) const {
+        _for_each(root.get(), visit);
+    }
+
+    /**
+     * @brief Método que visita em ordem os elementos no intervalo fechado [lo, hi], em
+     * O(log n + k)
+     *
+     * @param lo Limite inferior
+     * @param hi Limite superior
+     * @param visit Função chamada com cada elemento do intervalo
+     */
+    template <typename Visitor>
+    void for_each_in_range(const T& lo, const T& hi, Visitor visit) const {
+        _for_each_in_range(root.get(), lo, hi, visit);
+    }
+
+    /**
+     * @brief Método que retorna um iterador para o menor elemento desta versão
+     *
+     * @return Iterador para o início da ordem
+     */
+    iterator begin() const {
+        return iterator(root);
+    }
+
+    /**
+     * @brief Método que retorna o iterador de fim da ordem
+     *
+     * @return Iterador de fim
+     */
+    iterator end() const {
+        return iterator();
+    }
+};
+
+#endif  // PERSISTENTAVL_H
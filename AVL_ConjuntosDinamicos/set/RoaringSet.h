@@ -0,0 +1,1375 @@
+/**
+ * @file RoaringSet.h
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief TAD para representar um conjunto de inteiros em blocos ao estilo Roaring. As chaves são
+ * agrupadas pelos 16 bits mais altos; cada bloco guarda os 16 bits baixos em um vetor ordenado,
+ * em um bitmap de 65536 bits ou em sequências (runs), o que ocupar menos memória. Faixas densas de
+ * inteiros custam poucos bits por elemento, em vez de um node de árvore por elemento.
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#ifndef ROARINGSET_H
+#define ROARINGSET_H
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+class RoaringSet {
+   private:
+    static constexpr int ARRAY_MAX = 4096;    // acima disso um vetor ocupa mais que o bitmap
+    static constexpr int WORDS = 1024;        // palavras de 64 bits de um bitmap
+    static constexpr int BITMAP_BYTES = 8192;  // tamanho de um bitmap em bytes
+
+    enum class BitOp { Or, And, AndNot };
+
+    /**
+     * @brief Conta os bits 1 de uma palavra
+     *
+     */
+    static int _popcount(std::uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(w);
+#else
+        int count = 0;
+        for (; w != 0; w &= w - 1) {
+            count++;
+        }
+        return count;
+#endif
+    }
+
+    /**
+     * @brief Retorna a posição do bit 1 mais baixo de uma palavra não nula
+     *
+     */
+    static int _lowest_bit(std::uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(w);
+#else
+        int i = 0;
+        while (!(w & 1)) {
+            w >>= 1;
+            i++;
+        }
+        return i;
+#endif
+    }
+
+    /**
+     * @brief Retorna a posição do bit 1 mais alto de uma palavra não nula
+     *
+     */
+    static int _highest_bit(std::uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(w);
+#else
+        int i = 0;
+        while (w >>= 1) {
+            i++;
+        }
+        return i;
+#endif
+    }
+
+    /**
+     * @brief Aplica uma operação bit a bit entre dois bitmaps, 256 bits por vez quando há AVX2
+     *
+     * @tparam Op Operação: Or (união), And (interseção) ou AndNot (a sem b)
+     * @param out Bitmap de saída (pode ser o próprio a)
+     * @param a Primeiro bitmap
+     * @param b Segundo bitmap
+     */
+    template <BitOp Op>
+    static void _word_op(std::uint64_t* out, const std::uint64_t* a, const std::uint64_t* b) {
+        int i = 0;
+#if defined(__AVX2__)
+        for (; i + 4 <= WORDS; i += 4) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            __m256i r;
+            if constexpr (Op == BitOp::Or) {
+                r = _mm256_or_si256(x, y);
+            } else if constexpr (Op == BitOp::And) {
+                r = _mm256_and_si256(x, y);
+            } else {
+                r = _mm256_andnot_si256(y, x);
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+        }
+#endif
+        for (; i < WORDS; i++) {
+            if constexpr (Op == BitOp::Or) {
+                out[i] = a[i] | b[i];
+            } else if constexpr (Op == BitOp::And) {
+                out[i] = a[i] & b[i];
+            } else {
+                out[i] = a[i] & ~b[i];
+            }
+        }
+    }
+
+    /**
+     * @brief Sequência de valores consecutivos [start, start + length]
+     *
+     */
+    struct Run {
+        std::uint16_t start;   // primeiro valor
+        std::uint16_t length;  // quantidade de valores depois do primeiro
+
+        int end() const {
+            return start + length;
+        }
+    };
+
+    /**
+     * @brief Os 16 bits baixos das chaves de um bloco, em uma das três representações
+     *
+     */
+    struct Container {
+        enum class Kind : unsigned char { Array, Bitmap, Run };
+
+        Kind kind = Kind::Array;
+        int card{};                          // quantidade de valores
+        std::vector<std::uint16_t> array{};  // valores em ordem (Array)
+        std::vector<std::uint64_t> bits{};   // WORDS palavras (Bitmap)
+        std::vector<Run> runs{};             // sequências em ordem e separadas (Run)
+
+        /**
+         * @brief Verifica se o bloco contém x
+         *
+         */
+        bool contains(int x) const {
+            switch (kind) {
+                case Kind::Array:
+                    return std::binary_search(array.begin(), array.end(), static_cast<std::uint16_t>(x));
+                case Kind::Bitmap:
+                    return (bits[x >> 6] >> (x & 63)) & 1;
+                default: {
+                    int i = _run_at(x);
+                    return i >= 0;
+                }
+            }
+        }
+
+        /**
+         * @brief Retorna o índice da sequência que contém x, ou -1
+         *
+         */
+        int _run_at(int x) const {
+            auto it = std::upper_bound(runs.begin(), runs.end(), x,
+                                       [](int v, const Run& r) { return v < r.start; });
+            if (it == runs.begin() || std::prev(it)->end() < x) {
+                return -1;
+            }
+            return static_cast<int>(it - runs.begin()) - 1;
+        }
+
+        /**
+         * @brief Insere x. Um vetor que passa de ARRAY_MAX vira bitmap; sequências que deixam de
+         * ser a menor representação são convertidas.
+         *
+         * @return true se x não estava no bloco
+         */
+        bool add(int x) {
+            switch (kind) {
+                case Kind::Array: {
+                    auto it = std::lower_bound(array.begin(), array.end(), static_cast<std::uint16_t>(x));
+                    if (it != array.end() && *it == x) {
+                        return false;
+                    }
+                    array.insert(it, static_cast<std::uint16_t>(x));
+                    card++;
+                    if (card > ARRAY_MAX) {
+                        to_bitmap();
+                    }
+                    return true;
+                }
+                case Kind::Bitmap: {
+                    std::uint64_t mask = std::uint64_t(1) << (x & 63);
+                    if (bits[x >> 6] & mask) {
+                        return false;
+                    }
+                    bits[x >> 6] |= mask;
+                    card++;
+                    return true;
+                }
+                default:
+                    break;
+            }
+            auto it = std::upper_bound(runs.begin(), runs.end(), x, [](int v, const Run& r) { return v < r.start; });
+            bool joins_prev = false;
+            if (it != runs.begin()) {
+                Run& prev = *std::prev(it);
+                if (x <= prev.end()) {
+                    return false;
+                }
+                joins_prev = (prev.end() + 1 == x);
+            }
+            bool joins_next = (it != runs.end() && it->start == x + 1);
+            if (joins_prev && joins_next) {
+                Run& prev = *std::prev(it);
+                prev.length = static_cast<std::uint16_t>(it->end() - prev.start);
+                runs.erase(it);
+            } else if (joins_prev) {
+                std::prev(it)->length++;
+            } else if (joins_next) {
+                it->start--;
+                it->length++;
+            } else {
+                runs.insert(it, Run{static_cast<std::uint16_t>(x), 0});
+            }
+            card++;
+            _leave_runs_if_larger();
+            return true;
+        }
+
+        /**
+         * @brief Remove x. Um bitmap que cai para ARRAY_MAX vira vetor.
+         *
+         * @return true se x estava no bloco
+         */
+        bool remove(int x) {
+            switch (kind) {
+                case Kind::Array: {
+                    auto it = std::lower_bound(array.begin(), array.end(), static_cast<std::uint16_t>(x));
+                    if (it == array.end() || *it != x) {
+                        return false;
+                    }
+                    array.erase(it);
+                    card--;
+                    return true;
+                }
+                case Kind::Bitmap: {
+                    std::uint64_t mask = std::uint64_t(1) << (x & 63);
+                    if (!(bits[x >> 6] & mask)) {
+                        return false;
+                    }
+                    bits[x >> 6] &= ~mask;
+                    card--;
+                    if (card <= ARRAY_MAX) {
+                        to_array();
+                    }
+                    return true;
+                }
+                default:
+                    break;
+            }
+            int i = _run_at(x);
+            if (i < 0) {
+                return false;
+            }
+            Run& r = runs[i];
+            if (r.length == 0) {
+                runs.erase(runs.begin() + i);
+            } else if (x == r.start) {
+                r.start++;
+                r.length--;
+            } else if (x == r.end()) {
+                r.length--;
+            } else {
+                Run rest{static_cast<std::uint16_t>(x + 1), static_cast<std::uint16_t>(r.end() - x - 1)};
+                r.length = static_cast<std::uint16_t>(x - 1 - r.start);
+                runs.insert(runs.begin() + i + 1, rest);
+            }
+            card--;
+            _leave_runs_if_larger();
+            return true;
+        }
+
+        /**
+         * @brief Posiciona um cursor no primeiro valor maior ou igual a x
+         *
+         * @param x Valor de referência (até 65536)
+         * @param low Saída: valor encontrado
+         * @param pos Saída: índice no vetor ou nas sequências
+         * @return true se existe tal valor
+         */
+        bool seek(int x, int& low, int& pos) const {
+            switch (kind) {
+                case Kind::Array:
+                    pos = static_cast<int>(std::lower_bound(array.begin(), array.end(), x) - array.begin());
+                    if (pos == card) {
+                        return false;
+                    }
+                    low = array[pos];
+                    return true;
+                case Kind::Bitmap:
+                    low = _next_bit(x);
+                    return low >= 0;
+                default: {
+                    auto it = std::lower_bound(runs.begin(), runs.end(), x,
+                                               [](const Run& r, int v) { return r.end() < v; });
+                    if (it == runs.end()) {
+                        return false;
+                    }
+                    pos = static_cast<int>(it - runs.begin());
+                    low = std::max<int>(it->start, x);
+                    return true;
+                }
+            }
+        }
+
+        /**
+         * @brief Avança um cursor para o próximo valor
+         *
+         * @return true se existe um próximo valor
+         */
+        bool next(int& low, int& pos) const {
+            switch (kind) {
+                case Kind::Array:
+                    if (++pos == card) {
+                        return false;
+                    }
+                    low = array[pos];
+                    return true;
+                case Kind::Bitmap:
+                    low = _next_bit(low + 1);
+                    return low >= 0;
+                default:
+                    if (low < runs[pos].end()) {
+                        low++;
+                        return true;
+                    }
+                    if (++pos == static_cast<int>(runs.size())) {
+                        return false;
+                    }
+                    low = runs[pos].start;
+                    return true;
+            }
+        }
+
+        /**
+         * @brief Retorna o primeiro bit 1 do bitmap a partir de x, ou -1
+         *
+         */
+        int _next_bit(int x) const {
+            if (x >= WORDS * 64) {
+                return -1;
+            }
+            int w = x >> 6;
+            std::uint64_t word = bits[w] & (~std::uint64_t(0) << (x & 63));
+            while (word == 0) {
+                if (++w == WORDS) {
+                    return -1;
+                }
+                word = bits[w];
+            }
+            return w * 64 + _lowest_bit(word);
+        }
+
+        /**
+         * @brief Retorna o maior valor menor ou igual a x, ou -1
+         *
+         */
+        int prev(int x) const {
+            if (x < 0) {
+                return -1;
+            }
+            switch (kind) {
+                case Kind::Array: {
+                    auto it = std::upper_bound(array.begin(), array.end(), x);
+                    return (it == array.begin()) ? -1 : *std::prev(it);
+                }
+                case Kind::Bitmap: {
+                    int w = x >> 6;
+                    std::uint64_t word = bits[w] & (~std::uint64_t(0) >> (63 - (x & 63)));
+                    while (word == 0) {
+                        if (w-- == 0) {
+                            return -1;
+                        }
+                        word = bits[w];
+                    }
+                    return w * 64 + _highest_bit(word);
+                }
+                default: {
+                    auto it = std::upper_bound(runs.begin(), runs.end(), x,
+                                               [](int v, const Run& r) { return v < r.start; });
+                    return (it == runs.begin()) ? -1 : std::min(std::prev(it)->end(), x);
+                }
+            }
+        }
+
+        /**
+         * @brief Conta os valores menores que x
+         *
+         */
+        int rank(int x) const {
+            switch (kind) {
+                case Kind::Array:
+                    return static_cast<int>(std::lower_bound(array.begin(), array.end(), x) - array.begin());
+                case Kind::Bitmap: {
+                    int count = 0;
+                    int w = x >> 6;
+                    for (int i = 0; i < w && i < WORDS; i++) {
+                        count += _popcount(bits[i]);
+                    }
+                    if (w < WORDS) {
+                        count += _popcount(bits[w] & ((std::uint64_t(1) << (x & 63)) - 1));
+                    }
+                    return count;
+                }
+                default: {
+                    int count = 0;
+                    for (const Run& r : runs) {
+                        if (r.start >= x) {
+                            break;
+                        }
+                        count += std::min(r.end() + 1, x) - r.start;
+                    }
+                    return count;
+                }
+            }
+        }
+
+        /**
+         * @brief Retorna o k-ésimo menor valor, com 0 <= k < card
+         *
+         */
+        int select(int k) const {
+            switch (kind) {
+                case Kind::Array:
+                    return array[k];
+                case Kind::Bitmap:
+                    for (int w = 0;; w++) {
+                        int c = _popcount(bits[w]);
+                        if (k < c) {
+                            std::uint64_t word = bits[w];
+                            for (; k > 0; k--) {
+                                word &= word - 1;
+                            }
+                            return w * 64 + _lowest_bit(word);
+                        }
+                        k -= c;
+                    }
+                default:
+                    for (const Run& r : runs) {
+                        if (k <= r.length) {
+                            return r.start + k;
+                        }
+                        k -= r.length + 1;
+                    }
+                    return -1;
+            }
+        }
+
+        /**
+         * @brief Visita os valores em ordem
+         *
+         */
+        template <typename F>
+        void for_each(F f) const {
+            int low = 0;
+            int pos = 0;
+            for (bool ok = seek(0, low, pos); ok; ok = next(low, pos)) {
+                f(low);
+            }
+        }
+
+        /**
+         * @brief Conta as sequências de valores consecutivos
+         *
+         */
+        int count_runs() const {
+            switch (kind) {
+                case Kind::Array: {
+                    int count = 0;
+                    for (int i = 0; i < card; i++) {
+                        count += (i == 0 || array[i] != array[i - 1] + 1);
+                    }
+                    return count;
+                }
+                case Kind::Bitmap: {
+                    int count = 0;
+                    std::uint64_t carry = 0;
+                    for (int i = 0; i < WORDS; i++) {
+                        count += _popcount(bits[i] & ~((bits[i] << 1) | carry));  // bits que iniciam sequência
+                        carry = bits[i] >> 63;
+                    }
+                    return count;
+                }
+                default:
+                    return static_cast<int>(runs.size());
+            }
+        }
+
+        /**
+         * @brief Tamanho em bytes dos dados de cada representação
+         *
+         */
+        static int array_bytes(int card) {
+            return 2 * card;
+        }
+
+        static int run_bytes(int runs) {
+            return 4 * runs;
+        }
+
+        /**
+         * @brief Converte para vetor ordenado
+         *
+         */
+        void to_array() {
+            if (kind == Kind::Array) {
+                return;
+            }
+            std::vector<std::uint16_t> values;
+            values.reserve(card);
+            for_each([&](int v) { values.push_back(static_cast<std::uint16_t>(v)); });
+            array.swap(values);
+            bits = {};
+            runs = {};
+            kind = Kind::Array;
+        }
+
+        /**
+         * @brief Converte para bitmap
+         *
+         */
+        void to_bitmap() {
+            if (kind == Kind::Bitmap) {
+                return;
+            }
+            std::vector<std::uint64_t> words(WORDS, 0);
+            if (kind == Kind::Array) {
+                for (std::uint16_t v : array) {
+                    words[v >> 6] |= std::uint64_t(1) << (v & 63);
+                }
+            } else {
+                for (const Run& r : runs) {
+                    for (int v = r.start; v <= r.end(); v++) {
+                        words[v >> 6] |= std::uint64_t(1) << (v & 63);
+                    }
+                }
+            }
+            bits.swap(words);
+            array = {};
+            runs = {};
+            kind = Kind::Bitmap;
+        }
+
+        /**
+         * @brief Converte para sequências
+         *
+         */
+        void to_runs() {
+            if (kind == Kind::Run) {
+                return;
+            }
+            std::vector<Run> result;
+            for_each([&](int v) {
+                if (!result.empty() && result.back().end() + 1 == v) {
+                    result.back().length++;
+                } else {
+                    result.push_back(Run{static_cast<std::uint16_t>(v), 0});
+                }
+            });
+            runs.swap(result);
+            array = {};
+            bits = {};
+            kind = Kind::Run;
+        }
+
+        /**
+         * @brief Sai das sequências quando vetor ou bitmap ficaria menor
+         *
+         */
+        void _leave_runs_if_larger() {
+            int size = run_bytes(static_cast<int>(runs.size()));
+            if (card <= ARRAY_MAX && array_bytes(card) < size) {
+                to_array();
+            } else if (card > ARRAY_MAX && BITMAP_BYTES < size) {
+                to_bitmap();
+            }
+        }
+
+        /**
+         * @brief Escolhe a representação que ocupa menos memória
+         *
+         */
+        void shrink() {
+            int runs_size = run_bytes(count_runs());
+            int plain_size = (card <= ARRAY_MAX) ? array_bytes(card) : BITMAP_BYTES;
+            if (runs_size < plain_size) {
+                to_runs();
+            } else if (card <= ARRAY_MAX) {
+                to_array();
+            } else {
+                to_bitmap();
+            }
+            array.shrink_to_fit();
+            runs.shrink_to_fit();
+        }
+
+        /**
+         * @brief Retorna uma cópia como vetor ou bitmap, para as operações entre blocos
+         *
+         */
+        Container plain() const {
+            Container c = *this;
+            if (c.kind == Kind::Run) {
+                if (c.card <= ARRAY_MAX) {
+                    c.to_array();
+                } else {
+                    c.to_bitmap();
+                }
+            }
+            return c;
+        }
+
+        /**
+         * @brief Recalcula card de um bitmap
+         *
+         */
+        void _recount() {
+            card = 0;
+            for (std::uint64_t w : bits) {
+                card += _popcount(w);
+            }
+        }
+
+        /**
+         * @brief Retorna c como vetor ou bitmap sem copiar: só um bloco Run é convertido, em tmp
+         *
+         */
+        static const Container& _plain(const Container& c, Container& tmp) {
+            if (c.kind != Kind::Run) {
+                return c;
+            }
+            tmp = c.plain();
+            return tmp;
+        }
+
+        /**
+         * @brief Retorna um bloco que pode ser alterado com o conteúdo de c: move tmp se c é a
+         * conversão guardada nele e só copia c caso contrário
+         *
+         */
+        static Container _take(const Container& c, Container& tmp) {
+            if (&c == &tmp) {
+                return std::move(tmp);
+            }
+            return c;
+        }
+
+        /**
+         * @brief União de dois blocos. Só o bitmap que recebe o resultado é copiado.
+         *
+         */
+        static Container unite(const Container& x, const Container& y) {
+            Container tx, ty;
+            const Container& a = _plain(x, tx);
+            const Container& b = _plain(y, ty);
+            if (a.kind == Kind::Array && b.kind == Kind::Array) {
+                Container c;
+                c.array.reserve(a.card + b.card);
+                std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                               std::back_inserter(c.array));
+                c.card = static_cast<int>(c.array.size());
+                c.shrink();
+                return c;
+            }
+            bool a_bitmap = (a.kind == Kind::Bitmap);
+            const Container& other = a_bitmap ? b : a;
+            Container c = a_bitmap ? _take(a, tx) : _take(b, ty);
+            if (other.kind == Kind::Bitmap) {
+                _word_op<BitOp::Or>(c.bits.data(), c.bits.data(), other.bits.data());
+            } else {
+                for (std::uint16_t v : other.array) {
+                    c.bits[v >> 6] |= std::uint64_t(1) << (v & 63);
+                }
+            }
+            c._recount();
+            c.shrink();
+            return c;
+        }
+
+        /**
+         * @brief Interseção de dois blocos. Só copia um bloco quando os dois são bitmaps.
+         *
+         */
+        static Container intersect(const Container& x, const Container& y) {
+            Container tx, ty;
+            const Container& a = _plain(x, tx);
+            const Container& b = _plain(y, ty);
+            if (a.kind == Kind::Bitmap && b.kind == Kind::Bitmap) {
+                Container c = _take(a, tx);
+                _word_op<BitOp::And>(c.bits.data(), c.bits.data(), b.bits.data());
+                c._recount();
+                c.shrink();
+                return c;
+            }
+            const Container& small = (a.kind == Kind::Array) ? a : b;
+            const Container& other = (a.kind == Kind::Array) ? b : a;
+            Container c;
+            if (other.kind == Kind::Array) {
+                std::set_intersection(small.array.begin(), small.array.end(), other.array.begin(),
+                                      other.array.end(), std::back_inserter(c.array));
+            } else {
+                for (std::uint16_t v : small.array) {
+                    if (other.contains(v)) {
+                        c.array.push_back(v);
+                    }
+                }
+            }
+            c.card = static_cast<int>(c.array.size());
+            c.shrink();
+            return c;
+        }
+
+        /**
+         * @brief Diferença de dois blocos (x sem y). Só copia x quando ele é um bitmap.
+         *
+         */
+        static Container subtract(const Container& x, const Container& y) {
+            Container tx, ty;
+            const Container& a = _plain(x, tx);
+            const Container& b = _plain(y, ty);
+            if (a.kind == Kind::Bitmap) {
+                Container c = _take(a, tx);
+                if (b.kind == Kind::Bitmap) {
+                    _word_op<BitOp::AndNot>(c.bits.data(), c.bits.data(), b.bits.data());
+                } else {
+                    for (std::uint16_t v : b.array) {
+                        c.bits[v >> 6] &= ~(std::uint64_t(1) << (v & 63));
+                    }
+                }
+                c._recount();
+                c.shrink();
+                return c;
+            }
+            Container c;
+            if (b.kind == Kind::Array) {
+                std::set_difference(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                                    std::back_inserter(c.array));
+            } else {
+                for (std::uint16_t v : a.array) {
+                    if (!b.contains(v)) {
+                        c.array.push_back(v);
+                    }
+                }
+            }
+            c.card = static_cast<int>(c.array.size());
+            c.shrink();
+            return c;
+        }
+
+        /**
+         * @brief Bytes ocupados pelos dados do bloco
+         *
+         */
+        std::size_t bytes() const {
+            return array.capacity() * sizeof(std::uint16_t) + bits.capacity() * sizeof(std::uint64_t) +
+                   runs.capacity() * sizeof(Run);
+        }
+    };
+
+    /**
+     * @brief Bloco com as chaves cujos 16 bits altos valem key
+     *
+     */
+    struct Chunk {
+        std::uint16_t key;  // 16 bits altos das chaves do bloco
+        Container values;   // 16 bits baixos
+    };
+
+    std::vector<Chunk> chunks{};  // blocos não vazios em ordem de key
+    int total{};                  // quantidade de elementos
+
+    /**
+     * @brief Método privado que leva um int para um uint32 com a mesma ordem
+     *
+     */
+    static std::uint32_t _encode(int key) {
+        return static_cast<std::uint32_t>(key) ^ 0x80000000u;
+    }
+
+    /**
+     * @brief Método privado que desfaz _encode a partir do bloco e dos bits baixos
+     *
+     */
+    static int _decode(std::uint16_t high, int low) {
+        return static_cast<int>(((static_cast<std::uint32_t>(high) << 16) | static_cast<std::uint32_t>(low)) ^
+                                0x80000000u);
+    }
+
+    /**
+     * @brief Método privado que retorna o índice do primeiro bloco com key >= high
+     *
+     */
+    std::size_t _chunk_index(std::uint16_t high) const {
+        return std::lower_bound(chunks.begin(), chunks.end(), high,
+                                [](const Chunk& c, std::uint16_t h) { return c.key < h; }) -
+               chunks.begin();
+    }
+
+    /**
+     * @brief Método privado que conta os elementos menores que uma chave já codificada
+     *
+     * @param value Chave codificada, podendo valer 2^32 (conta todos)
+     */
+    int _rank(std::uint64_t value) const {
+        int count = 0;
+        for (const Chunk& c : chunks) {
+            std::uint64_t base = static_cast<std::uint64_t>(c.key) << 16;
+            if (value <= base) {
+                break;
+            }
+            if (value >= base + 65536) {
+                count += c.values.card;
+            } else {
+                count += c.values.rank(static_cast<int>(value - base));
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Método privado que combina os blocos de dois conjuntos
+     *
+     * @param other Outro conjunto
+     * @param op Operação entre dois blocos com a mesma key
+     * @param keep_left Mantém blocos que só existem neste conjunto
+     * @param keep_right Mantém blocos que só existem em other
+     * @return Conjunto resultante
+     */
+    template <typename Op>
+    RoaringSet _combine(const RoaringSet& other, Op op, bool keep_left, bool keep_right) const {
+        RoaringSet result;
+        std::size_t i = 0;
+        std::size_t j = 0;
+        while (i < chunks.size() || j < other.chunks.size()) {
+            if (j == other.chunks.size() || (i < chunks.size() && chunks[i].key < other.chunks[j].key)) {
+                if (keep_left) {
+                    result._append(chunks[i]);
+                }
+                i++;
+            } else if (i == chunks.size() || other.chunks[j].key < chunks[i].key) {
+                if (keep_right) {
+                    result._append(other.chunks[j]);
+                }
+                j++;
+            } else {
+                result._append(Chunk{chunks[i].key, op(chunks[i].values, other.chunks[j].values)});
+                i++;
+                j++;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Método privado que acrescenta um bloco no fim, se não estiver vazio
+     *
+     */
+    void _append(Chunk chunk) {
+        if (chunk.values.card > 0) {
+            total += chunk.values.card;
+            chunks.push_back(std::move(chunk));
+        }
+    }
+
+   public:
+    /**
+     * @brief Iterador que percorre os elementos em ordem crescente. Os elementos não existem
+     * como objetos na memória, então o iterador devolve cópias.
+     *
+     */
+    class iterator {
+       private:
+        const RoaringSet* set{};
+        std::size_t chunk{};  // bloco atual; chunks.size() é o fim
+        int low{};            // 16 bits baixos do elemento atual
+        int pos{};            // posição no vetor ou nas sequências do bloco
+
+        friend class RoaringSet;
+
+        iterator(const RoaringSet* set, std::size_t chunk, int low, int pos)
+            : set(set), chunk(chunk), low(low), pos(pos) {}
+
+        /**
+         * @brief Posiciona no primeiro elemento do bloco atual ou dos seguintes cujos 16 bits baixos
+         * sejam >= x
+         *
+         */
+        void _settle(int x) {
+            for (; chunk < set->chunks.size(); chunk++, x = 0) {
+                if (set->chunks[chunk].values.seek(x, low, pos)) {
+                    return;
+                }
+            }
+            low = pos = 0;
+        }
+
+       public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int*;
+        using reference = int;
+
+        iterator() = default;
+
+        int operator*() const {
+            return _decode(set->chunks[chunk].key, low);
+        }
+
+        iterator& operator++() {
+            if (!set->chunks[chunk].values.next(low, pos)) {
+                chunk++;
+                _settle(0);
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const iterator& other) const {
+            return chunk == other.chunk && low == other.low;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    using const_iterator = iterator;
+
+    /**
+     * @brief Construtor padrão. Cria um conjunto vazio.
+     *
+     */
+    RoaringSet() = default;
+
+    /**
+     * @brief Cria um conjunto a partir de uma sequência de inteiros. Sequências fora de ordem ou
+     * com repetições são ordenadas e deduplicadas antes; cada bloco é montado de uma vez e já
+     * na menor representação.
+     *
+     * @param first início da sequência
+     * @param last fim da sequência
+     * @return RoaringSet conjunto com os elementos da sequência
+     */
+    template <typename It>
+    static RoaringSet from_sorted(It first, It last) {
+        std::vector<int> keys(first, last);
+        if (std::adjacent_find(keys.begin(), keys.end(), std::greater_equal<int>()) != keys.end()) {
+            std::sort(keys.begin(), keys.end());
+            keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        }
+        RoaringSet set;
+        for (int key : keys) {
+            std::uint32_t u = _encode(key);
+            std::uint16_t high = static_cast<std::uint16_t>(u >> 16);
+            if (set.chunks.empty() || set.chunks.back().key != high) {
+                set.chunks.push_back(Chunk{high, Container{}});
+            }
+            Container& c = set.chunks.back().values;
+            c.array.push_back(static_cast<std::uint16_t>(u));
+            c.card++;
+        }
+        for (Chunk& chunk : set.chunks) {
+            chunk.values.shrink();
+        }
+        set.total = static_cast<int>(keys.size());
+        return set;
+    }
+
+    /**
+     * @brief Remove todos os elementos do conjunto.
+     *
+     */
+    void clear() {
+        chunks.clear();
+        total = 0;
+    }
+
+    /**
+     * @brief Insere um inteiro no conjunto.
+     *
+     * @param key inteiro a ser inserido
+     */
+    void insert(int key) {
+        std::uint32_t u = _encode(key);
+        std::uint16_t high = static_cast<std::uint16_t>(u >> 16);
+        std::size_t i = _chunk_index(high);
+        if (i == chunks.size() || chunks[i].key != high) {
+            chunks.insert(chunks.begin() + i, Chunk{high, Container{}});
+        }
+        total += chunks[i].values.add(u & 0xFFFF);
+    }
+
+    /**
+     * @brief Remove um inteiro do conjunto. Blocos que ficam vazios são descartados.
+     *
+     * @param key inteiro a ser removido
+     */
+    void erase(int key) {
+        std::uint32_t u = _encode(key);
+        std::uint16_t high = static_cast<std::uint16_t>(u >> 16);
+        std::size_t i = _chunk_index(high);
+        if (i == chunks.size() || chunks[i].key != high || !chunks[i].values.remove(u & 0xFFFF)) {
+            return;
+        }
+        total--;
+        if (chunks[i].values.card == 0) {
+            chunks.erase(chunks.begin() + i);
+        }
+    }
+
+    /**
+     * @brief Insere um lote de inteiros, montando um conjunto com o lote e unindo os blocos.
+     *
+     * @param first início do lote
+     * @param last fim do lote
+     * @return int quantidade de inteiros que não estavam no conjunto
+     */
+    template <typename It>
+    int insert_batch(It first, It last) {
+        int before = total;
+        unite(from_sorted(first, last));
+        return total - before;
+    }
+
+    /**
+     * @brief Remove um lote de inteiros, subtraindo os blocos de um conjunto montado com o lote.
+     *
+     * @param first início do lote
+     * @param last fim do lote
+     * @return int quantidade de inteiros que estavam no conjunto
+     */
+    template <typename It>
+    int erase_batch(It first, It last) {
+        int before = total;
+        subtract(from_sorted(first, last));
+        return before - total;
+    }
+
+    /**
+     * @brief Verifica se um inteiro está no conjunto.
+     *
+     * @param key inteiro a ser verificado
+     * @return true se o inteiro está no conjunto, false caso contrário
+     */
+    bool contains(int key) const {
+        std::uint32_t u = _encode(key);
+        std::uint16_t high = static_cast<std::uint16_t>(u >> 16);
+        std::size_t i = _chunk_index(high);
+        return i < chunks.size() && chunks[i].key == high && chunks[i].values.contains(u & 0xFFFF);
+    }
+
+    /**
+     * @brief Troca o conteúdo de dois conjuntos.
+     *
+     * @param other conjunto a ser trocado
+     */
+    void swap(RoaringSet& other) noexcept {
+        chunks.swap(other.chunks);
+        std::swap(total, other.total);
+    }
+
+    /**
+     * @brief Retorna um iterador para o menor elemento do conjunto.
+     *
+     * @return iterator início do conjunto
+     */
+    iterator begin() const {
+        iterator it(this, 0, 0, 0);
+        it._settle(0);
+        return it;
+    }
+
+    /**
+     * @brief Retorna um iterador para depois do maior elemento do conjunto.
+     *
+     * @return iterator fim do conjunto
+     */
+    iterator end() const {
+        return iterator(this, chunks.size(), 0, 0);
+    }
+
+    /**
+     * @brief Retorna um iterador para o primeiro elemento maior ou igual a key.
+     *
+     * @param key elemento de referência (não precisa estar no conjunto)
+     * @return iterator elemento encontrado, ou end()
+     */
+    iterator lower_bound(int key) const {
+        std::uint32_t u = _encode(key);
+        std::uint16_t high = static_cast<std::uint16_t>(u >> 16);
+        iterator it(this, _chunk_index(high), 0, 0);
+        it._settle((it.chunk < chunks.size() && chunks[it.chunk].key == high) ? static_cast<int>(u & 0xFFFF) : 0);
+        return it;
+    }
+
+    /**
+     * @brief Retorna um iterador para o primeiro elemento maior que key.
+     *
+     * @param key elemento de referência (não precisa estar no conjunto)
+     * @return iterator elemento encontrado, ou end()
+     */
+    iterator upper_bound(int key) const {
+        return (key == INT_MAX) ? end() : lower_bound(key + 1);
+    }
+
+    /**
+     * @brief Visita, em ordem crescente, os elementos do conjunto em [lo, hi].
+     *
+     * @param lo limite inferior
+     * @param hi limite superior
+     * @param visit função chamada com cada elemento do intervalo
+     */
+    template <typename Visitor>
+    void for_each_in_range(int lo, int hi, Visitor visit) const {
+        for (iterator it = lower_bound(lo); it != end() && *it <= hi; ++it) {
+            visit(*it);
+        }
+    }
+
+    /**
+     * @brief Retorna o menor elemento do conjunto.
+     *
+     * @return int menor elemento do conjunto
+     */
+    int minimum() const {
+        if (total == 0) {
+            throw std::runtime_error("Conjunto vazio");
+        }
+        return *begin();
+    }
+
+    /**
+     * @brief Retorna o maior elemento do conjunto.
+     *
+     * @return int maior elemento do conjunto
+     */
+    int maximum() const {
+        if (total == 0) {
+            throw std::runtime_error("Conjunto vazio");
+        }
+        const Chunk& last = chunks.back();
+        return _decode(last.key, last.values.prev(65535));
+    }
+
+    /**
+     * @brief Retorna o número de elementos no conjunto.
+     *
+     * @return int número de elementos no conjunto
+     */
+    int size() const {
+        return total;
+    }
+
+    /**
+     * @brief Verifica se o conjunto está vazio.
+     *
+     * @return true se o conjunto está vazio, false caso contrário
+     */
+    bool empty() const {
+        return total == 0;
+    }
+
+    /**
+     * @brief Retorna quantos elementos do conjunto são menores que key, somando as quantidades
+     * dos blocos anteriores.
+     *
+     * @param key elemento de referência (não precisa estar no conjunto)
+     * @return int posição de key na ordem, começando em 0
+     */
+    int rank(int key) const {
+        return _rank(_encode(key));
+    }
+
+    /**
+     * @brief Retorna o k-ésimo menor elemento do conjunto, com k começando em 0.
+     *
+     * @param k posição do elemento na ordem
+     * @return int elemento na posição k
+     */
+    int select(int k) const {
+        if (k < 0 || k >= total) {
+            throw std::runtime_error("Posição inválida");
+        }
+        for (const Chunk& c : chunks) {
+            if (k < c.values.card) {
+                return _decode(c.key, c.values.select(k));
+            }
+            k -= c.values.card;
+        }
+        throw std::runtime_error("Posição inválida");
+    }
+
+    /**
+     * @brief Conta os elementos do conjunto no intervalo fechado [lo, hi].
+     *
+     * @param lo limite inferior
+     * @param hi limite superior
+     * @return int quantidade de elementos no intervalo
+     */
+    int count_range(int lo, int hi) const {
+        if (hi < lo) {
+            return 0;
+        }
+        return _rank(static_cast<std::uint64_t>(_encode(hi)) + 1) - _rank(_encode(lo));
+    }
+
+    /**
+     * @brief Retorna o sucessor de um elemento no conjunto.
+     *
+     * @param key elemento a ser verificado
+     * @return Sucessor do elemento
+     */
+    int successor(int key) const {
+        if (!contains(key)) {
+            throw std::runtime_error("Elemento não está no conjunto");
+        }
+        iterator it = upper_bound(key);
+        if (it == end()) {
+            throw std::runtime_error("Não existe sucessor");
+        }
+        return *it;
+    }
+
+    /**
+     * @brief Retorna o predecessor de um elemento no conjunto: o anterior no mesmo bloco ou o
+     * maior do bloco anterior.
+     *
+     * @param key elemento a ser verificado
+     * @return Predecessor do elemento
+     */
+    int predecessor(int key) const {
+        if (!contains(key)) {
+            throw std::runtime_error("Elemento não está no conjunto");
+        }
+        std::uint32_t u = _encode(key);
+        std::size_t i = _chunk_index(static_cast<std::uint16_t>(u >> 16));
+        int low = chunks[i].values.prev(static_cast<int>(u & 0xFFFF) - 1);
+        if (low >= 0) {
+            return _decode(chunks[i].key, low);
+        }
+        if (i == 0) {
+            throw std::runtime_error("Não existe antecessor");
+        }
+        return _decode(chunks[i - 1].key, chunks[i - 1].values.prev(65535));
+    }
+
+    /**
+     * @brief Método que retorna a união de dois conjuntos. Blocos com a mesma key são combinados
+     * conforme as representações: bitmaps palavra a palavra, vetores por intercalação.
+     *
+     * @param other Conjunto a ser unido
+     * @return União dos conjuntos
+     */
+    RoaringSet unionSets(const RoaringSet& other) const {
+        return _combine(other, Container::unite, true, true);
+    }
+
+    /**
+     * @brief Método que retorna a interseção de dois conjuntos. Só blocos com key nos dois lados
+     * são combinados.
+     *
+     * @param other Conjunto a ser intersecionado
+     * @return Interseção dos conjuntos
+     */
+    RoaringSet intersectionSets(const RoaringSet& other) const {
+        return _combine(other, Container::intersect, false, false);
+    }
+
+    /**
+     * @brief Método que retorna a diferença de dois conjuntos.
+     *
+     * @param other Conjunto a ser comparado
+     * @return Diferença dos conjuntos
+     */
+    RoaringSet differenceSets(const RoaringSet& other) const {
+        return _combine(other, Container::subtract, true, false);
+    }
+
+    /**
+     * @brief Método que une other a este conjunto.
+     *
+     * @param other Conjunto a ser unido
+     */
+    void unite(const RoaringSet& other) {
+        unionSets(other).swap(*this);
+    }
+
+    /**
+     * @brief Método que mantém no conjunto só os elementos que também estão em other.
+     *
+     * @param other Conjunto a ser intersecionado
+     */
+    void intersect(const RoaringSet& other) {
+        intersectionSets(other).swap(*this);
+    }
+
+    /**
+     * @brief Método que tira do conjunto os elementos que estão em other.
+     *
+     * @param other Conjunto a ser subtraído
+     */
+    void subtract(const RoaringSet& other) {
+        differenceSets(other).swap(*this);
+    }
+
+    /**
+     * @brief Revê a representação de todos os blocos. Inserções e remoções isoladas só trocam
+     * entre vetor e bitmap no limite de ARRAY_MAX; depois de muitas delas, optimize passa para
+     * sequências os blocos em que elas ocupam menos.
+     *
+     */
+    void optimize() {
+        for (Chunk& chunk : chunks) {
+            chunk.values.shrink();
+        }
+    }
+
+    /**
+     * @brief Retorna a memória ocupada pelos blocos, em bytes.
+     *
+     * @return std::size_t bytes
+     */
+    std::size_t memory_usage() const {
+        std::size_t bytes = chunks.capacity() * sizeof(Chunk);
+        for (const Chunk& chunk : chunks) {
+            bytes += chunk.values.bytes();
+        }
+        return bytes;
+    }
+
+    // ********************** Sobrecarga de operadores **********************
+
+    /**
+     * @brief Sobrecarga do operador de inserção << para imprimir o conjunto.
+     * @return Um objeto ostream com o conjunto formatado.
+     *
+     */
+    friend std::ostream& operator<<(std::ostream& os, const RoaringSet& set) {
+        os << "[ ";
+        for (int key : set) {
+            os << key << " ";
+        }
+        os << "]";
+        return os;
+    }
+};
+
+#endif  // ROARINGSET_H
@@ -2,6 +2,8 @@
  * @file Set.h
  * @author Júnior Silva (junior.silva@alu.ufc.br)
  * @brief TAD para representar um conjunto de inteiros. O conjunto é implementado utilizando uma árvore AVL.
+ * Conjuntos pequenos guardam os elementos em um vetor ordenado dentro do próprio objeto e só
+ * passam para a árvore quando crescem.
  * @version 0.1
  * @date 07-05-2024
  *
@@ -11,40 +13,241 @@
 #ifndef SET_H
 #define SET_H
 
+#include <algorithm>
 #include <iostream>
-#include <sstream>
+#include <iterator>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "AVL.h"
+#include "PersistentAVL.h"
 
 class Set {
    private:
-    AVL_Tree<int> tree{};  // Árvore AVL que armazena os elementos do conjunto
-    int m_size{};          // Número de elementos no conjunto
+    static constexpr int SMALL_MAX = 32;              // elementos que cabem no vetor interno
+    static constexpr int DEMOTE_AT = SMALL_MAX / 2;  // tamanho em que a árvore volta para o vetor
+
+    int small[SMALL_MAX]{};  // elementos em ordem crescente enquanto o conjunto é pequeno
+    int small_count{};       // quantidade de elementos em small
+    bool large{};            // true se os elementos estão na árvore
+    AVL_Tree<int> tree{};    // Árvore AVL que armazena os elementos do conjunto
+
+    /**
+     * @brief Construtor privado que cria um conjunto a partir de uma árvore já montada. Árvores
+     * com até SMALL_MAX elementos são copiadas para o vetor interno.
+     *
+     * @param tree árvore com os elementos do conjunto
+     */
+    explicit Set(AVL_Tree<int>&& tree) : large(true), tree(std::move(tree)) {
+        _demote(SMALL_MAX);
+    }
+
+    /**
+     * @brief Método privado que retorna a posição do primeiro elemento do vetor interno maior ou
+     * igual a key
+     *
+     * @param key elemento de referência
+     * @return int* posição em small
+     */
+    int* _small_lower(int key) {
+        return std::lower_bound(small, small + small_count, key);
+    }
+
+    const int* _small_lower(int key) const {
+        return std::lower_bound(small, small + small_count, key);
+    }
 
     /**
-     * @brief Método privado que retorna uma string em ordem da subárvore.
+     * @brief Método privado que passa os elementos do vetor interno para a árvore
      *
-     * @param node Node a ser verificado
-     * @return String em ordem da subárvore
      */
-    std::string inOrder() {
-        return tree.inOrder();
+    void _promote() {
+        tree = AVL_Tree<int>::from_sorted(small, small + small_count);
+        small_count = 0;
+        large = true;
+    }
+
+    /**
+     * @brief Método privado que volta para o vetor interno se a árvore tem até limit elementos.
+     * O limite de remoção (DEMOTE_AT) é menor que SMALL_MAX para que um conjunto perto do limite
+     * não fique trocando de modo a cada inserção e remoção.
+     *
+     * @param limit tamanho máximo para voltar ao vetor
+     */
+    void _demote(int limit) {
+        if (!large || tree.size() > limit) {
+            return;
+        }
+        small_count = 0;
+        for (int key : tree) {
+            small[small_count++] = key;
+        }
+        tree.clear();
+        large = false;
     }
 
    public:
     /**
-     * @brief Construtor padrão da classe Set. Cria um conjunto vazio.
+     * @brief Iterador que percorre os elementos em ordem crescente, tanto no vetor interno quanto
+     * na árvore. Como os iteradores da árvore, é invalidado quando o conjunto muda de modo.
+     *
+     */
+    class iterator {
+       private:
+        const int* p{};                // posição no vetor interno (modo pequeno)
+        AVL_Tree<int>::iterator it{};  // posição na árvore (modo árvore)
+
+        friend class Set;
+
+        explicit iterator(const int* p) : p(p) {}
+        explicit iterator(AVL_Tree<int>::iterator it) : it(it) {}
+
+       public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int*;
+        using reference = const int&;
+
+        iterator() = default;
+
+        reference operator*() const {
+            return (p != nullptr) ? *p : *it;
+        }
+
+        pointer operator->() const {
+            return &**this;
+        }
+
+        iterator& operator++() {
+            if (p != nullptr) {
+                ++p;
+            } else {
+                ++it;
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        iterator& operator--() {
+            if (p != nullptr) {
+                --p;
+            } else {
+                --it;
+            }
+            return *this;
+        }
+
+        iterator operator--(int) {
+            iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const iterator& other) const {
+            return p == other.p && it == other.it;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    using const_iterator = iterator;
+
+    /**
+     * @brief Construtor padrão da classe Set. Cria um conjunto vazio, sem alocar memória.
      *
      */
-    Set() : m_size(0) {}
+    Set() = default;
 
     /**
-     * @brief Destrutor da classe Set. Libera a memória alocada.
+     * @brief Cria um conjunto a partir de uma sequência de inteiros em tempo linear. Sequências
+     * fora de ordem ou com repetições são ordenadas e deduplicadas antes.
      *
+     * @param first início da sequência
+     * @param last fim da sequência
+     * @return Set conjunto com os elementos da sequência
      */
-    ~Set() {
-        clear();
+    template <typename It>
+    static Set from_sorted(It first, It last) {
+        if (std::distance(first, last) > SMALL_MAX) {
+            return Set(AVL_Tree<int>::from_sorted(first, last));
+        }
+        Set set;
+        int* end = std::copy(first, last, set.small);
+        std::sort(set.small, end);
+        set.small_count = static_cast<int>(std::unique(set.small, end) - set.small);
+        return set;
+    }
+
+    /**
+     * @brief Cria um conjunto com os elementos de uma versão de Persistent_AVL_Tree, em tempo
+     * linear. Permite usar as operações de Set, como intersectionSets, sobre um snapshot antigo
+     * enquanto outras versões continuam sendo alteradas.
+     *
+     * @param version versão da árvore persistente
+     * @return Set conjunto com os elementos da versão
+     */
+    static Set from_version(const Persistent_AVL_Tree<int>& version) {
+        std::vector<int> keys;
+        keys.reserve(version.size());
+        keys.assign(version.begin(), version.end());
+        return from_sorted(keys.begin(), keys.end());
+    }
+
+    /**
+     * @brief Congela o conjunto em um vetor imutável em layout de Eytzinger, com buscas sem
+     * ponteiros e sem desvios (ver FrozenAVL.h).
+     *
+     * @return Frozen_AVL_Tree<int, three_way> cópia congelada dos elementos
+     */
+    Frozen_AVL_Tree<int, three_way> freeze() const {
+        if (!large) {
+            return Frozen_AVL_Tree<int, three_way>(small, small_count);
+        }
+        return tree.freeze();
+    }
+
+    /**
+     * @brief Cria um conjunto mutável a partir de um conjunto congelado, em tempo linear.
+     *
+     * @param frozen conjunto congelado
+     * @return Set conjunto com os mesmos elementos
+     */
+    static Set thaw(const Frozen_AVL_Tree<int, three_way>& frozen) {
+        return Set(AVL_Tree<int>::thaw(frozen));
+    }
+
+    /**
+     * @brief Carrega um conjunto de um snapshot binário gravado por save.
+     *
+     * @param path caminho do arquivo
+     * @return Set conjunto com os elementos do snapshot
+     */
+    static Set load(const std::string& path) {
+        return Set(AVL_Tree<int>::load(path));
+    }
+
+    /**
+     * @brief Grava o conjunto em um snapshot binário: cabeçalho, quantidade e elementos em
+     * ordem, codificados pela diferença para o anterior.
+     *
+     * @param path caminho do arquivo
+     */
+    void save(const std::string& path) const {
+        if (!large) {
+            AVL_Tree<int>::from_sorted(small, small + small_count).save(path);
+            return;
+        }
+        tree.save(path);
     }
 
     /**
@@ -53,39 +256,127 @@ class Set {
      */
     void clear() {
         tree.clear();
-        m_size = 0;
+        small_count = 0;
+        large = false;
     }
 
     /**
-     * @brief Insere um inteiro no conjunto.
+     * @brief Insere um inteiro no conjunto. No modo pequeno, o inteiro é encaixado no vetor
+     * interno; se ele já está cheio, os elementos passam para a árvore.
      *
      * @param key inteiro a ser inserido
      */
     void insert(int key) {
-        tree.add(key);
-        m_size++;
+        if (large) {
+            tree.add(key);
+            return;
+        }
+        int* pos = _small_lower(key);
+        if (pos != small + small_count && *pos == key) {
+            return;
+        }
+        if (small_count == SMALL_MAX) {
+            _promote();
+            tree.add(key);
+            return;
+        }
+        std::copy_backward(pos, small + small_count, small + small_count + 1);
+        *pos = key;
+        small_count++;
+    }
+
+    /**
+     * @brief Insere um inteiro usando como dica um vizinho dele no conjunto. Inserções em ordem
+     * crescente com insert_hint(end(), key), ou agrupadas passando o iterador devolvido pela
+     * inserção anterior, fazem O(1) comparações.
+     *
+     * @param hint elemento vizinho de key, ou end()
+     * @param key inteiro a ser inserido
+     * @return iterator posição de key no conjunto
+     */
+    iterator insert_hint(iterator hint, int key) {
+        if (large) {
+            return iterator(tree.add_hint(hint.it, key));
+        }
+        insert(key);
+        return lower_bound(key);
     }
 
     /**
-     * @brief Remove um inteiro do conjunto.
+     * @brief Remove um inteiro do conjunto. A árvore volta para o vetor interno quando fica com
+     * DEMOTE_AT elementos.
      *
      * @param key inteiro a ser removido
      */
     void erase(int key) {
-        if (contains(key)) {
-            tree.remove(key);
-            m_size--;
+        if (large) {
+            if (tree.remove(key)) {
+                _demote(DEMOTE_AT);
+            }
+            return;
         }
+        int* pos = _small_lower(key);
+        if (pos != small + small_count && *pos == key) {
+            std::copy(pos + 1, small + small_count, pos);
+            small_count--;
+        }
+    }
+
+    /**
+     * @brief Insere um lote de inteiros. A árvore é dividida pelo lote e as partes são processadas
+     * em paralelo (ver AVL_Tree::insert_batch). No modo pequeno, os inteiros são inseridos um a
+     * um até o vetor encher; o resto do lote vai de uma vez para a árvore.
+     *
+     * @param first início do lote
+     * @param last fim do lote
+     * @return int quantidade de inteiros que não estavam no conjunto
+     */
+    template <typename It>
+    int insert_batch(It first, It last) {
+        int before = size();
+        for (; first != last && !large; ++first) {
+            insert(*first);
+        }
+        if (first != last) {
+            tree.insert_batch(first, last);
+        }
+        return size() - before;
     }
 
     /**
-     * @brief Verifica se um inteiro está no conjunto.
+     * @brief Remove um lote de inteiros, processando as partes da árvore em paralelo.
+     *
+     * @param first início do lote
+     * @param last fim do lote
+     * @return int quantidade de inteiros que estavam no conjunto
+     */
+    template <typename It>
+    int erase_batch(It first, It last) {
+        int before = size();
+        if (large) {
+            tree.erase_batch(first, last);
+            _demote(DEMOTE_AT);
+        } else {
+            for (; first != last; ++first) {
+                erase(*first);
+            }
+        }
+        return before - size();
+    }
+
+    /**
+     * @brief Verifica se um inteiro está no conjunto. No modo pequeno é uma busca binária no
+     * vetor interno.
      *
      * @param key inteiro a ser verificado
      * @return true se o inteiro está no conjunto, false caso contrário
      */
-    bool contains(int key) {
-        return tree.contains(key);
+    bool contains(int key) const {
+        if (large) {
+            return tree.contains(key);
+        }
+        const int* pos = _small_lower(key);
+        return pos != small + small_count && *pos == key;
     }
 
     /**
@@ -94,8 +385,80 @@ class Set {
      * @param other conjunto a ser trocado
      */
     void swap(Set& other) {
+        std::swap_ranges(small, small + std::max(small_count, other.small_count), other.small);
+        std::swap(small_count, other.small_count);
+        std::swap(large, other.large);
         tree.swap(other.tree);
-        std::swap(m_size, other.m_size);
+    }
+
+    /**
+     * @brief Retorna um iterador para o menor elemento do conjunto. Os elementos são percorridos
+     * em ordem crescente.
+     *
+     * @return iterator início do conjunto
+     */
+    iterator begin() const {
+        return large ? iterator(tree.begin()) : iterator(small);
+    }
+
+    /**
+     * @brief Retorna um iterador para depois do maior elemento do conjunto.
+     *
+     * @return iterator fim do conjunto
+     */
+    iterator end() const {
+        return large ? iterator(tree.end()) : iterator(small + small_count);
+    }
+
+    /**
+     * @brief Retorna um iterador para o primeiro elemento maior ou igual a key.
+     *
+     * @param key elemento de referência (não precisa estar no conjunto)
+     * @return iterator elemento encontrado, ou end()
+     */
+    iterator lower_bound(int key) const {
+        return large ? iterator(tree.lower_bound(key)) : iterator(_small_lower(key));
+    }
+
+    /**
+     * @brief Retorna um iterador para o primeiro elemento maior que key.
+     *
+     * @param key elemento de referência (não precisa estar no conjunto)
+     * @return iterator elemento encontrado, ou end()
+     */
+    iterator upper_bound(int key) const {
+        if (large) {
+            return iterator(tree.upper_bound(key));
+        }
+        return iterator(std::upper_bound(small, small + small_count, key));
+    }
+
+    /**
+     * @brief Retorna o intervalo de elementos iguais a key (vazio ou com um elemento).
+     *
+     * @param key elemento de referência
+     * @return std::pair<iterator, iterator> par (lower_bound, upper_bound)
+     */
+    std::pair<iterator, iterator> equal_range(int key) const {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    /**
+     * @brief Visita, em ordem crescente, os elementos do conjunto em [lo, hi] em O(log n + k).
+     *
+     * @param lo limite inferior
+     * @param hi limite superior
+     * @param visit função chamada com cada elemento do intervalo
+     */
+    template <typename Visitor>
+    void for_each_in_range(int lo, int hi, Visitor visit) const {
+        if (large) {
+            tree.for_each_in_range(lo, hi, visit);
+            return;
+        }
+        for (const int* p = _small_lower(lo); p != small + small_count && *p <= hi; ++p) {
+            visit(*p);
+        }
     }
 
     /**
@@ -104,7 +467,7 @@ class Set {
      * @return int menor elemento do conjunto
      */
     int& minimum() {
-        return tree.minimum();
+        return large ? tree.minimum() : small[0];
     }
 
     /**
@@ -113,7 +476,7 @@ class Set {
      * @return int maior elemento do conjunto
      */
     int& maximum() {
-        return tree.maximum();
+        return large ? tree.maximum() : small[small_count - 1];
     }
 
     /**
@@ -121,8 +484,8 @@ class Set {
      *
      * @return int número de elementos no conjunto
      */
-    int size() {
-        return m_size;
+    int size() const {
+        return large ? tree.size() : small_count;
     }
 
     /**
@@ -130,8 +493,51 @@ class Set {
      *
      * @return true se o conjunto está vazio, false caso contrário
      */
-    bool empty() {
-        return m_size == 0;
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Retorna quantos elementos do conjunto são menores que key, em O(log n).
+     *
+     * @param key elemento de referência (não precisa estar no conjunto)
+     * @return int posição de key na ordem, começando em 0
+     */
+    int rank(int key) const {
+        return large ? tree.rank(key) : static_cast<int>(_small_lower(key) - small);
+    }
+
+    /**
+     * @brief Retorna o k-ésimo menor elemento do conjunto, com k começando em 0, em O(log n).
+     *
+     * @param k posição do elemento na ordem
+     * @return int elemento na posição k
+     */
+    int& select(int k) {
+        if (large) {
+            return tree.select(k);
+        }
+        if (k < 0 || k >= small_count) {
+            throw std::runtime_error("Posição inválida");
+        }
+        return small[k];
+    }
+
+    /**
+     * @brief Conta os elementos do conjunto no intervalo fechado [lo, hi], em O(log n).
+     *
+     * @param lo limite inferior
+     * @param hi limite superior
+     * @return int quantidade de elementos no intervalo
+     */
+    int count_range(int lo, int hi) const {
+        if (large) {
+            return tree.count_range(lo, hi);
+        }
+        if (hi < lo) {
+            return 0;
+        }
+        return static_cast<int>(std::upper_bound(small, small + small_count, hi) - _small_lower(lo));
     }
 
     /**
@@ -141,6 +547,16 @@ class Set {
      * @return Sucessor do elemento
      */
     int& successor(const int& key) {
+        if (!large) {
+            int* pos = _small_lower(key);
+            if (pos == small + small_count || *pos != key) {
+                throw std::runtime_error("Elemento não está no conjunto");
+            }
+            if (pos + 1 == small + small_count) {
+                throw std::runtime_error("Não existe sucessor");
+            }
+            return pos[1];
+        }
         try {
             return tree.successor(key);
         } catch (std::runtime_error& e) {
@@ -155,6 +571,16 @@ class Set {
      * @return Predecessor do elemento
      */
     int& predecessor(const int& key) {
+        if (!large) {
+            int* pos = _small_lower(key);
+            if (pos == small + small_count || *pos != key) {
+                throw std::runtime_error("Elemento não está no conjunto");
+            }
+            if (pos == small) {
+                throw std::runtime_error("Não existe antecessor");
+            }
+            return pos[-1];
+        }
         try {
             return tree.predecessor(key);
         } catch (std::runtime_error& e) {
@@ -163,71 +589,139 @@ class Set {
     }
 
     /**
-     * @brief Método que retorna a união de dois conjuntos.
+     * @brief Método que retorna a união de dois conjuntos. Os dois conjuntos são percorridos em
+     * ordem ao mesmo tempo e o resultado, já ordenado, é montado em tempo linear: O(n + m).
      *
      * @param other Conjunto a ser unido
      * @return União dos conjuntos
      */
-    Set unionSets(Set& other) {
-        Set new_set;
-
-        std::string inOrder = tree.inOrder();
-        std::istringstream iss(inOrder);
-        int key;
-        while (iss >> key) {
-            new_set.insert(key);
-        }
-
-        inOrder = other.tree.inOrder();
-        iss.clear();
-        iss.str(inOrder);
-        while (iss >> key) {
-            new_set.insert(key);
-        }
-
-        return new_set;
+    Set unionSets(const Set& other) const {
+        std::vector<int> keys;
+        keys.reserve(size() + other.size());
+        std::set_union(begin(), end(), other.begin(), other.end(), std::back_inserter(keys));
+        return from_sorted(keys.begin(), keys.end());
     }
 
     /**
-     * @brief Método que retorna a interseção de dois conjuntos.
+     * @brief Método que retorna a interseção de dois conjuntos, com um único percurso em ordem
+     * dos dois: O(n + m).
      *
      * @param other Conjunto a ser intersecionado
      * @return Interseção dos conjuntos
      */
-    Set intersectionSets(Set& other) {
-        Set new_set;
+    Set intersectionSets(const Set& other) const {
+        std::vector<int> keys;
+        keys.reserve(std::min(size(), other.size()));
+        std::set_intersection(begin(), end(), other.begin(), other.end(), std::back_inserter(keys));
+        return from_sorted(keys.begin(), keys.end());
+    }
 
-        std::string inOrder = tree.inOrder();
-        std::istringstream iss(inOrder);
-        int key;
-        while (iss >> key) {
-            if (other.contains(key)) {
-                new_set.insert(key);
+    /**
+     * @brief Método que retorna a diferença de dois conjuntos, com um único percurso em ordem dos
+     * dois: O(n + m).
+     *
+     * @param other Conjunto a ser comparado
+     * @return Diferença dos conjuntos
+     */
+    Set differenceSets(const Set& other) const {
+        std::vector<int> keys;
+        keys.reserve(size());
+        std::set_difference(begin(), end(), other.begin(), other.end(), std::back_inserter(keys));
+        return from_sorted(keys.begin(), keys.end());
+    }
+
+    /**
+     * @brief Método que une other a este conjunto no lugar, por divisão e junção das árvores
+     * (split/join) em O(m log(n/m + 1)), com m o tamanho do menor conjunto. Para conjuntos de
+     * tamanhos muito diferentes, custa bem menos que unionSets; em conjuntos grandes, as
+     * subárvores independentes são processadas em paralelo. Um lado pequeno é inserido
+     * elemento a elemento.
+     *
+     * @param other Conjunto a ser unido
+     */
+    void unite(const Set& other) {
+        if (large && other.large) {
+            tree.unite(other.tree);
+        } else if (!other.large) {
+            for (int i = 0, n = other.small_count; i < n; i++) {
+                insert(other.small[i]);
             }
+        } else {
+            Set result(AVL_Tree<int>(other.tree));
+            result.unite(*this);
+            swap(result);
         }
-
-        return new_set;
     }
 
     /**
-     * @brief Método que retorna a diferença de dois conjuntos.
+     * @brief Versão de unite que aproveita os nodes de other, sem copiá-los. other fica vazio.
      *
-     * @param other Conjunto a ser comparado
-     * @return Diferença dos conjuntos
+     * @param other Conjunto a ser unido (movido)
      */
-    Set differenceSets(Set& other) {
-        Set new_set;
+    void unite(Set&& other) {
+        if (&other == this) {
+            return;
+        }
+        if (large && other.large) {
+            tree.unite(std::move(other.tree));
+        } else if (!other.large) {
+            unite(static_cast<const Set&>(other));
+        } else {
+            other.unite(static_cast<const Set&>(*this));
+            swap(other);
+        }
+        other.clear();
+    }
 
-        std::string inOrder = tree.inOrder();
-        std::istringstream iss(inOrder);
-        int key;
-        while (iss >> key) {
-            if (!other.contains(key)) {
-                new_set.insert(key);
+    /**
+     * @brief Método que mantém no conjunto só os elementos que também estão em other, por
+     * split/join em O(m log(n/m + 1)). Se um dos lados é pequeno, o resultado cabe no vetor
+     * interno e é montado procurando os elementos desse lado no outro.
+     *
+     * @param other Conjunto a ser intersecionado
+     */
+    void intersect(const Set& other) {
+        if (large && other.large) {
+            tree.intersect(other.tree);
+            _demote(DEMOTE_AT);
+            return;
+        }
+        const Set& smaller = large ? other : *this;
+        const Set& larger = large ? *this : other;
+        int kept[SMALL_MAX];
+        int n = 0;
+        for (int i = 0; i < smaller.small_count; i++) {
+            if (larger.contains(smaller.small[i])) {
+                kept[n++] = smaller.small[i];
             }
         }
+        tree.clear();
+        large = false;
+        std::copy(kept, kept + n, small);
+        small_count = n;
+    }
 
-        return new_set;
+    /**
+     * @brief Método que tira do conjunto os elementos que estão em other, por split/join em
+     * O(m log(n/m + 1))
+     *
+     * @param other Conjunto a ser subtraído
+     */
+    void subtract(const Set& other) {
+        if (&other == this) {
+            clear();
+        } else if (large && other.large) {
+            tree.subtract(other.tree);
+            _demote(DEMOTE_AT);
+        } else if (!other.large) {
+            for (int i = 0; i < other.small_count; i++) {
+                erase(other.small[i]);
+            }
+        } else {
+            small_count = static_cast<int>(std::remove_if(small, small + small_count,
+                                                          [&other](int key) { return other.contains(key); }) -
+                                           small);
+        }
     }
 
     // ********************** Sobrecarga de operadores **********************
@@ -237,10 +731,14 @@ class Set {
      * @return Um objeto ostream com o conjunto formatado.
      *
      */
-    friend std::ostream& operator<<(std::ostream& os, Set& set) {
-        os << "[ " << set.inOrder() << "]";
+    friend std::ostream& operator<<(std::ostream& os, const Set& set) {
+        os << "[ ";
+        for (int key : set) {
+            os << key << " ";
+        }
+        os << "]";
         return os;
     }
 };
 
-#endif  // SET_H
\ No newline at end of file
+#endif  // SET_H
@@ -0,0 +1,292 @@
+/**
+ * @file ShardedSet.h
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief TAD para representar um conjunto de inteiros que pode ser usado por várias threads. As
+ * chaves são divididas por faixas entre várias árvores AVL (shards), cada uma com o seu próprio
+ * lock de leitura e escrita, então operações em faixas diferentes não disputam o mesmo lock.
+ * A divisão é por faixa, e não por hash, para que mínimo, sucessor e consultas de intervalo
+ * continuem percorrendo os shards em ordem. Por isso o equilíbrio da carga depende da faixa
+ * informada na construção: ela deve ser a faixa em que as chaves realmente caem, pois chaves
+ * concentradas em um pedaço pequeno dela acabam todas no mesmo shard.
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#ifndef SHARDEDSET_H
+#define SHARDEDSET_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "AVL.h"
+
+class ShardedSet {
+   private:
+    /**
+     * @brief Uma faixa de chaves com a sua árvore e o seu lock. Alinhada à linha de cache para
+     * que locks de shards vizinhos não compartilhem linha.
+     *
+     */
+    struct alignas(64) Shard {
+        mutable std::shared_mutex lock{};  // leitores compartilham, escritores sao exclusivos
+        AVL_Tree<int> tree{};              // chaves da faixa
+    };
+
+    std::unique_ptr<Shard[]> shards{};  // shards em ordem crescente de faixa
+    int n{};                            // quantidade de shards
+    std::int64_t base{};                // inicio da faixa dividida
+    std::int64_t width{};               // largura da faixa dividida
+
+    /**
+     * @brief Retorna o shard responsável por uma chave. Chaves fora de [lo, hi] vão para o
+     * primeiro ou o último shard, então a ordem entre shards é sempre a ordem das chaves.
+     *
+     * @param key chave
+     * @return int índice do shard
+     */
+    int shard_of(int key) const {
+        std::int64_t offset = static_cast<std::int64_t>(key) - base;
+        if (offset < 0) {
+            return 0;
+        }
+        if (offset >= width) {
+            return n - 1;
+        }
+        return static_cast<int>(offset * n / width);
+    }
+
+   public:
+    /**
+     * @brief Cria o conjunto dividindo a faixa [lo, hi] em partes iguais. Não há faixa padrão: com
+     * [INT_MIN, INT_MAX], chaves usuais (pequenas, não negativas) cairiam todas em um ou dois
+     * shards. Chaves fora da faixa continuam válidas, mas vão para o primeiro ou o último shard.
+     *
+     * @param lo início da faixa em que as chaves caem
+     * @param hi fim da faixa em que as chaves caem
+     * @param shard_count quantidade de shards (padrão: quantidade de núcleos)
+     */
+    ShardedSet(int lo, int hi, int shard_count = static_cast<int>(std::thread::hardware_concurrency()))
+        : n(shard_count > 0 ? shard_count : 1), base(lo), width(static_cast<std::int64_t>(hi) - lo + 1) {
+        if (hi < lo) {
+            throw std::invalid_argument("Faixa inválida");
+        }
+        shards.reset(new Shard[n]);
+    }
+
+    ShardedSet(const ShardedSet&) = delete;
+    ShardedSet& operator=(const ShardedSet&) = delete;
+
+    /**
+     * @brief Insere um inteiro no conjunto. Trava só o shard da chave.
+     *
+     * @param key inteiro a ser inserido
+     * @return true se foi inserido, false se já existia
+     */
+    bool insert(int key) {
+        Shard& s = shards[shard_of(key)];
+        std::unique_lock<std::shared_mutex> guard(s.lock);
+        return s.tree.add(key);
+    }
+
+    /**
+     * @brief Remove um inteiro do conjunto. Trava só o shard da chave.
+     *
+     * @param key inteiro a ser removido
+     * @return true se foi removido, false se não existia
+     */
+    bool erase(int key) {
+        Shard& s = shards[shard_of(key)];
+        std::unique_lock<std::shared_mutex> guard(s.lock);
+        return s.tree.remove(key);
+    }
+
+    /**
+     * @brief Verifica se um inteiro está no conjunto. Leitores do mesmo shard não se bloqueiam.
+     *
+     * @param key inteiro a ser verificado
+     * @return true se está, false caso contrário
+     */
+    bool contains(int key) const {
+        const Shard& s = shards[shard_of(key)];
+        std::shared_lock<std::shared_mutex> guard(s.lock);
+        return s.tree.contains(key);
+    }
+
+    /**
+     * @brief Retorna o menor elemento, procurando do primeiro shard em diante.
+     *
+     * @return int menor elemento
+     */
+    int minimum() const {
+        for (int i = 0; i < n; i++) {
+            std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+            if (shards[i].tree.size() > 0) {
+                return *shards[i].tree.begin();
+            }
+        }
+        throw std::runtime_error("Conjunto vazio");
+    }
+
+    /**
+     * @brief Retorna o maior elemento, procurando do último shard para trás.
+     *
+     * @return int maior elemento
+     */
+    int maximum() const {
+        for (int i = n - 1; i >= 0; i--) {
+            std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+            if (shards[i].tree.size() > 0) {
+                return *--shards[i].tree.end();
+            }
+        }
+        throw std::runtime_error("Conjunto vazio");
+    }
+
+    /**
+     * @brief Retorna o sucessor de um elemento. Se ele for o maior do seu shard, o sucessor é o
+     * menor elemento do próximo shard não vazio.
+     *
+     * @param key elemento do conjunto
+     * @return int sucessor
+     */
+    int successor(int key) const {
+        int i = shard_of(key);
+        {
+            std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+            const AVL_Tree<int>& tree = shards[i].tree;
+            if (!tree.contains(key)) {
+                throw std::runtime_error("Elemento não está no conjunto");
+            }
+            auto it = tree.upper_bound(key);
+            if (it != tree.end()) {
+                return *it;
+            }
+        }
+        for (i++; i < n; i++) {
+            std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+            if (shards[i].tree.size() > 0) {
+                return *shards[i].tree.begin();
+            }
+        }
+        throw std::runtime_error("Não existe sucessor");
+    }
+
+    /**
+     * @brief Retorna o antecessor de um elemento. Se ele for o menor do seu shard, o antecessor
+     * é o maior elemento do shard não vazio anterior.
+     *
+     * @param key elemento do conjunto
+     * @return int antecessor
+     */
+    int predecessor(int key) const {
+        int i = shard_of(key);
+        {
+            std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+            const AVL_Tree<int>& tree = shards[i].tree;
+            if (!tree.contains(key)) {
+                throw std::runtime_error("Elemento não está no conjunto");
+            }
+            auto it = tree.lower_bound(key);
+            if (it != tree.begin()) {
+                return *--it;
+            }
+        }
+        for (i--; i >= 0; i--) {
+            std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+            if (shards[i].tree.size() > 0) {
+                return *--shards[i].tree.end();
+            }
+        }
+        throw std::runtime_error("Não existe antecessor");
+    }
+
+    /**
+     * @brief Visita em ordem os elementos em [lo, hi], passando pelos shards da faixa um de cada
+     * vez. Cada shard é lido de forma consistente, mas alterações em shards ainda não visitados
+     * podem aparecer no resultado.
+     *
+     * @param lo início da faixa
+     * @param hi fim da faixa
+     * @param visit função chamada com cada elemento (com o lock de leitura do shard)
+     */
+    template <typename Visitor>
+    void for_each_in_range(int lo, int hi, Visitor visit) const {
+        if (hi < lo) {
+            return;
+        }
+        for (int i = shard_of(lo), last = shard_of(hi); i <= last; i++) {
+            std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+            shards[i].tree.for_each_in_range(lo, hi, visit);
+        }
+    }
+
+    /**
+     * @brief Conta os elementos em [lo, hi], somando a contagem O(log n) de cada shard da faixa.
+     *
+     * @param lo início da faixa
+     * @param hi fim da faixa
+     * @return int quantidade de elementos
+     */
+    int count_range(int lo, int hi) const {
+        if (hi < lo) {
+            return 0;
+        }
+        int count = 0;
+        for (int i = shard_of(lo), last = shard_of(hi); i <= last; i++) {
+            std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+            count += shards[i].tree.count_range(lo, hi);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Retorna o número de elementos, somando os shards.
+     *
+     * @return int número de elementos
+     */
+    int size() const {
+        int total = 0;
+        for (int i = 0; i < n; i++) {
+            std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+            total += shards[i].tree.size();
+        }
+        return total;
+    }
+
+    /**
+     * @brief Verifica se o conjunto está vazio.
+     *
+     * @return true se está vazio, false caso contrário
+     */
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Remove todos os elementos, um shard de cada vez.
+     *
+     */
+    void clear() {
+        for (int i = 0; i < n; i++) {
+            std::unique_lock<std::shared_mutex> guard(shards[i].lock);
+            shards[i].tree.clear();
+        }
+    }
+
+    /**
+     * @brief Retorna a quantidade de shards.
+     *
+     * @return int
+     */
+    int shard_count() const {
+        return n;
+    }
+};
+
+#endif  // SHARDEDSET_H
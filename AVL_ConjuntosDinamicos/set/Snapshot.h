@@ -0,0 +1,290 @@
+/**
+ * @file Snapshot.h
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief Formato binário de snapshot para conjuntos de inteiros. O arquivo tem um cabeçalho
+ * ("AVLS", versão e quantidade de chaves) seguido das chaves em ordem, cada uma gravada como a
+ * diferença para a anterior em zigzag + varint (LEB128). Chaves próximas ocupam 1 ou 2 bytes.
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SNAPSHOT_MMAP 1
+#endif
+
+/**
+ * @brief Constantes e funções de codificação do formato de snapshot
+ *
+ */
+struct Snapshot {
+    static constexpr char MAGIC[4] = {'A', 'V', 'L', 'S'};
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::size_t HEADER_SIZE = 16;  // magic (4) + versão (4) + quantidade (8)
+
+    /**
+     * @brief Grava um inteiro sem sinal em little-endian com o número de bytes dado
+     *
+     * @param out Buffer de saída
+     * @param value Valor a ser gravado
+     * @param bytes Quantidade de bytes
+     */
+    static void put_fixed(std::vector<unsigned char>& out, std::uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+        }
+    }
+
+    /**
+     * @brief Lê um inteiro sem sinal em little-endian com o número de bytes dado
+     *
+     * @param in Início dos bytes
+     * @param bytes Quantidade de bytes
+     * @return Valor lido
+     */
+    static std::uint64_t get_fixed(const unsigned char* in, int bytes) {
+        std::uint64_t value = 0;
+        for (int i = 0; i < bytes; i++) {
+            value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    /**
+     * @brief Grava a diferença entre duas chaves em zigzag + varint
+     *
+     * @param out Buffer de saída
+     * @param delta Diferença (em aritmética módulo 2^64)
+     */
+    static void put_delta(std::vector<unsigned char>& out, std::uint64_t delta) {
+        std::uint64_t z = (delta << 1) ^ static_cast<std::uint64_t>(static_cast<std::int64_t>(delta) >> 63);
+        while (z >= 0x80) {
+            out.push_back(static_cast<unsigned char>(z | 0x80));
+            z >>= 7;
+        }
+        out.push_back(static_cast<unsigned char>(z));
+    }
+
+    /**
+     * @brief Lê uma diferença gravada por put_delta, avançando o cursor
+     *
+     * @param cur Cursor de leitura
+     * @param end Fim dos dados
+     * @return Diferença (em aritmética módulo 2^64)
+     */
+    static std::uint64_t get_delta(const unsigned char*& cur, const unsigned char* end) {
+        std::uint64_t z = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (cur == end) {
+                throw std::runtime_error("Snapshot corrompido");
+            }
+            unsigned char byte = *cur++;
+            z |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return (z >> 1) ^ (~(z & 1) + 1);
+            }
+        }
+        throw std::runtime_error("Snapshot corrompido");
+    }
+
+    /**
+     * @brief Grava um snapshot com as chaves de uma sequência já ordenada
+     *
+     * @tparam T Tipo inteiro das chaves
+     * @param path Caminho do arquivo
+     * @param first Início da sequência
+     * @param last Fim da sequência
+     * @param n Quantidade de chaves
+     */
+    template <typename T, typename It>
+    static void write(const std::string& path, It first, It last, std::size_t n) {
+        static_assert(std::is_integral<T>::value, "Snapshot só suporta chaves inteiras");
+        std::vector<unsigned char> buffer;
+        buffer.reserve(HEADER_SIZE + n * 2);
+        buffer.insert(buffer.end(), MAGIC, MAGIC + 4);
+        put_fixed(buffer, VERSION, 4);
+        put_fixed(buffer, n, 8);
+        std::uint64_t prev = 0;
+        for (; first != last; ++first) {
+            std::uint64_t key = static_cast<std::uint64_t>(static_cast<T>(*first));
+            put_delta(buffer, key - prev);
+            prev = key;
+        }
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size())) {
+            throw std::runtime_error("Não foi possível gravar o arquivo " + path);
+        }
+    }
+
+    /**
+     * @brief Arquivo de snapshot aberto para leitura. Em sistemas POSIX o arquivo é mapeado com
+     * mmap; nos demais, é lido inteiro para a memória.
+     *
+     */
+    class File {
+       private:
+        const unsigned char* bytes{};
+        std::size_t length{};
+#ifdef SNAPSHOT_MMAP
+        void* mapping{};
+#else
+        std::vector<unsigned char> buffer{};
+#endif
+
+       public:
+        /**
+         * @brief Abre e valida o cabeçalho de um snapshot
+         *
+         * @param path Caminho do arquivo
+         */
+        explicit File(const std::string& path) {
+#ifdef SNAPSHOT_MMAP
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw std::runtime_error("Não foi possível abrir o arquivo " + path);
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                throw std::runtime_error("Não foi possível abrir o arquivo " + path);
+            }
+            length = static_cast<std::size_t>(st.st_size);
+            if (length > 0) {
+                mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            ::close(fd);
+            if (mapping == MAP_FAILED) {
+                mapping = nullptr;
+                throw std::runtime_error("Não foi possível mapear o arquivo " + path);
+            }
+            bytes = static_cast<const unsigned char*>(mapping);
+#else
+            std::ifstream file(path, std::ios::binary);
+            if (!file) {
+                throw std::runtime_error("Não foi possível abrir o arquivo " + path);
+            }
+            buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            bytes = buffer.data();
+            length = buffer.size();
+#endif
+            if (length < HEADER_SIZE || std::memcmp(bytes, MAGIC, 4) != 0 || get_fixed(bytes + 4, 4) != VERSION) {
+                release();
+                throw std::runtime_error("Arquivo não é um snapshot válido: " + path);
+            }
+        }
+
+        File(const File&) = delete;
+        File& operator=(const File&) = delete;
+
+        ~File() {
+            release();
+        }
+
+        /**
+         * @brief Desfaz o mapeamento do arquivo
+         *
+         */
+        void release() {
+#ifdef SNAPSHOT_MMAP
+            if (mapping != nullptr) {
+                ::munmap(mapping, length);
+                mapping = nullptr;
+            }
+#endif
+            bytes = nullptr;
+            length = 0;
+        }
+
+        /**
+         * @brief Retorna a quantidade de chaves gravada no cabeçalho
+         *
+         * @return Quantidade de chaves
+         */
+        std::uint64_t count() const {
+            return get_fixed(bytes + 8, 8);
+        }
+
+        /**
+         * @brief Retorna o início das chaves codificadas
+         *
+         */
+        const unsigned char* begin() const {
+            return bytes + HEADER_SIZE;
+        }
+
+        /**
+         * @brief Retorna o fim do arquivo
+         *
+         */
+        const unsigned char* end() const {
+            return bytes + length;
+        }
+    };
+
+    /**
+     * @brief Cursor que decodifica as chaves de um snapshot sob demanda, para alimentar uma
+     * construção linear sem vetor intermediário
+     *
+     * @tparam T Tipo inteiro das chaves
+     */
+    template <typename T>
+    class Reader {
+       private:
+        const unsigned char* cur;
+        const unsigned char* end;
+        std::uint64_t prev = 0;
+        std::uint64_t decoded = 0;
+        T value{};
+
+       public:
+        Reader(const unsigned char* begin, const unsigned char* end) : cur(begin), end(end) {
+            ++*this;
+        }
+
+        const T& operator*() const {
+            return value;
+        }
+
+        /**
+         * @brief Decodifica a próxima chave. Não lê além do fim dos dados.
+         *
+         */
+        Reader& operator++() {
+            if (cur != end) {
+                prev += get_delta(cur, end);
+                value = static_cast<T>(prev);
+                decoded++;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Verifica se foram decodificadas exatamente n chaves e todos os bytes foram
+         * consumidos
+         *
+         * @param n Quantidade esperada de chaves
+         */
+        bool consumed(std::uint64_t n) const {
+            return decoded == n && cur == end;
+        }
+    };
+};
+
+#endif  // SNAPSHOT_H
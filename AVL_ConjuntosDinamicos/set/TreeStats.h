@@ -0,0 +1,159 @@
+/**
+ * @file TreeStats.h
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief Políticas de instrumentação da árvore AVL. NoStats (padrão) não faz nada e some na
+ * compilação; CountingStats conta comparações, rotações por caso, profundidade das descidas e
+ * alocações de nodes.
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#ifndef TREESTATS_H
+#define TREESTATS_H
+
+#include <atomic>
+#include <cstdint>
+
+// Permite que a política vazia não ocupe espaço dentro da árvore
+#if defined(__has_cpp_attribute)
+#if __has_cpp_attribute(no_unique_address)
+#define AVL_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+#endif
+#ifndef AVL_NO_UNIQUE_ADDRESS
+#define AVL_NO_UNIQUE_ADDRESS
+#endif
+
+/**
+ * @brief Casos de rebalanceamento do fixup
+ *
+ */
+enum class Rotation {
+    LL,  // desbalanceado à esquerda, filho esquerdo pendendo à esquerda: rotação à direita
+    LR,  // desbalanceado à esquerda, filho esquerdo pendendo à direita: rotação dupla
+    RR,  // desbalanceado à direita, filho direito pendendo à direita: rotação à esquerda
+    RL   // desbalanceado à direita, filho direito pendendo à esquerda: rotação dupla
+};
+
+/**
+ * @brief Política padrão: todos os ganchos são vazios e são eliminados pelo compilador
+ *
+ */
+struct NoStats {
+    void comparison() const {}
+    void rotation(Rotation) const {}
+    void descent(int) const {}
+    void allocation() const {}
+    void deallocation(int) const {}
+};
+
+/**
+ * @brief Fotografia dos contadores de uma CountingStats
+ *
+ */
+struct TreeStats {
+    std::uint64_t comparisons{};    // chamadas ao comparador
+    std::uint64_t rotations_ll{};   // casos LL (rotação simples à direita)
+    std::uint64_t rotations_lr{};   // casos LR (rotação dupla esquerda-direita)
+    std::uint64_t rotations_rr{};   // casos RR (rotação simples à esquerda)
+    std::uint64_t rotations_rl{};   // casos RL (rotação dupla direita-esquerda)
+    std::uint64_t descents{};       // descidas da raiz até uma folha ou chave
+    std::uint64_t total_depth{};    // soma dos níveis visitados nas descidas
+    std::uint64_t max_depth{};      // maior descida
+    std::uint64_t allocations{};    // nodes criados
+    std::uint64_t deallocations{};  // nodes destruídos
+
+    /**
+     * @brief Retorna a profundidade média das descidas
+     *
+     * @return double
+     */
+    double mean_depth() const {
+        return (descents != 0) ? static_cast<double>(total_depth) / descents : 0.0;
+    }
+};
+
+/**
+ * @brief Política que conta os eventos da árvore. Os contadores são atômicos com ordem relaxada
+ * porque insert_batch e erase_batch comparam e rotacionam em várias threads.
+ *
+ */
+class CountingStats {
+   private:
+    enum { COMPARISONS, LL, LR, RR, RL, DESCENTS, TOTAL_DEPTH, MAX_DEPTH, ALLOCATIONS, DEALLOCATIONS, COUNT };
+
+    mutable std::atomic<std::uint64_t> counters[COUNT]{};
+
+    void add(int counter, std::uint64_t n) const {
+        counters[counter].fetch_add(n, std::memory_order_relaxed);
+    }
+
+   public:
+    CountingStats() = default;
+
+    // Os contadores pertencem a cada árvore: cópias começam zeradas
+    CountingStats(const CountingStats&) {}
+    CountingStats& operator=(const CountingStats&) {
+        return *this;
+    }
+
+    void comparison() const {
+        add(COMPARISONS, 1);
+    }
+
+    void rotation(Rotation r) const {
+        add(LL + static_cast<int>(r), 1);
+    }
+
+    void descent(int depth) const {
+        add(DESCENTS, 1);
+        add(TOTAL_DEPTH, depth);
+        std::uint64_t d = static_cast<std::uint64_t>(depth);
+        std::uint64_t max = counters[MAX_DEPTH].load(std::memory_order_relaxed);
+        while (d > max && !counters[MAX_DEPTH].compare_exchange_weak(max, d, std::memory_order_relaxed)) {
+        }
+    }
+
+    void allocation() const {
+        add(ALLOCATIONS, 1);
+    }
+
+    void deallocation(int n) const {
+        add(DEALLOCATIONS, n);
+    }
+
+    /**
+     * @brief Retorna uma fotografia dos contadores
+     *
+     * @return TreeStats
+     */
+    TreeStats snapshot() const {
+        auto get = [this](int counter) { return counters[counter].load(std::memory_order_relaxed); };
+        TreeStats s;
+        s.comparisons = get(COMPARISONS);
+        s.rotations_ll = get(LL);
+        s.rotations_lr = get(LR);
+        s.rotations_rr = get(RR);
+        s.rotations_rl = get(RL);
+        s.descents = get(DESCENTS);
+        s.total_depth = get(TOTAL_DEPTH);
+        s.max_depth = get(MAX_DEPTH);
+        s.allocations = get(ALLOCATIONS);
+        s.deallocations = get(DEALLOCATIONS);
+        return s;
+    }
+
+    /**
+     * @brief Zera todos os contadores
+     *
+     */
+    void reset() {
+        for (auto& counter : counters) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+#endif  // TREESTATS_H
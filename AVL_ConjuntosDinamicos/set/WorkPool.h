@@ -0,0 +1,273 @@
+/**
+ * @file WorkPool.h
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief Pool fixo de threads com roubo de tarefas (work stealing) para as divisões recursivas da
+ * árvore AVL. Cada thread do pool tem a sua fila: empilha e desempilha no fim (LIFO) e, sem
+ * trabalho, rouba do começo da fila de outra (as tarefas mais antigas, que são as maiores). As
+ * threads são criadas uma única vez, então dividir um lote em milhares de tarefas não cria
+ * milhares de threads.
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#ifndef WORKPOOL_H
+#define WORKPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkPool {
+   private:
+    /**
+     * @brief Tarefa empilhada por fork_join. Vive na pilha de quem a criou até done ficar true.
+     *
+     */
+    struct Task {
+        void (*run)(void*){};           // chama a função apontada por fn
+        void* fn{};                     // função da tarefa
+        std::atomic<bool> done{false};  // a tarefa terminou (com ou sem exceção)
+        std::exception_ptr error{};     // exceção lançada pela tarefa
+    };
+
+    /**
+     * @brief Fila de tarefas de uma thread. Alinhada à linha de cache para que filas vizinhas não
+     * compartilhem linha.
+     *
+     */
+    struct alignas(64) Queue {
+        std::mutex lock;            // protege tasks
+        std::deque<Task*> tasks{};  // tarefas empilhadas, a mais recente no fim
+    };
+
+    std::vector<std::thread> workers{};  // threads do pool
+    std::unique_ptr<Queue[]> queues{};   // uma por thread do pool e, no fim, a de threads de fora
+    int queue_count{};                   // workers.size() + 1
+    std::atomic<int> pending{0};         // tarefas esperando em alguma fila
+    std::atomic<bool> stopping{false};   // o destrutor pediu o fim das threads
+    std::mutex sleep_lock;               // protege a espera das threads sem trabalho
+    std::condition_variable wake{};      // acorda threads quando chega tarefa
+
+    /**
+     * @brief Pool dono da thread atual (nullptr se ela não é de nenhum pool)
+     *
+     */
+    static const WorkPool*& _owner() {
+        thread_local const WorkPool* owner = nullptr;
+        return owner;
+    }
+
+    /**
+     * @brief Índice da thread atual no seu pool, que é também o índice da sua fila
+     *
+     */
+    static int& _index() {
+        thread_local int index = -1;
+        return index;
+    }
+
+    /**
+     * @brief Coloca uma tarefa no fim de uma fila e acorda uma thread parada
+     *
+     */
+    void push(int q, Task* task) {
+        {
+            std::lock_guard<std::mutex> guard(queues[q].lock);
+            queues[q].tasks.push_back(task);
+        }
+        pending.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> guard(sleep_lock);
+        }
+        wake.notify_one();
+    }
+
+    /**
+     * @brief Tira task do fim da fila q se ela ainda estiver lá (ninguém a roubou)
+     *
+     * @return true se a tarefa foi retirada e deve ser executada por quem chamou
+     */
+    bool take_back(int q, Task* task) {
+        std::lock_guard<std::mutex> guard(queues[q].lock);
+        std::deque<Task*>& tasks = queues[q].tasks;
+        if (!tasks.empty() && tasks.back() == task) {
+            tasks.pop_back();
+            pending.fetch_sub(1);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Procura uma tarefa: primeiro no fim da própria fila, depois no começo das outras
+     *
+     * @param q Fila da thread que procura
+     * @return Tarefa retirada, ou nullptr se todas as filas estão vazias
+     */
+    Task* find(int q) {
+        if (pending.load() == 0) {
+            return nullptr;
+        }
+        for (int i = 0; i < queue_count; i++) {
+            int k = (q + i) % queue_count;
+            std::lock_guard<std::mutex> guard(queues[k].lock);
+            std::deque<Task*>& tasks = queues[k].tasks;
+            if (!tasks.empty()) {
+                Task* task;
+                if (k == q) {
+                    task = tasks.back();
+                    tasks.pop_back();
+                } else {
+                    task = tasks.front();
+                    tasks.pop_front();
+                }
+                pending.fetch_sub(1);
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Executa uma tarefa, guardando a exceção que ela lançar
+     *
+     */
+    static void execute(Task* task) {
+        try {
+            task->run(task->fn);
+        } catch (...) {
+            task->error = std::current_exception();
+        }
+        task->done.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Laço de uma thread do pool: executa tarefas enquanto houver e dorme quando não há
+     *
+     */
+    void work(int index) {
+        _owner() = this;
+        _index() = index;
+        while (true) {
+            Task* task = find(index);
+            if (task != nullptr) {
+                execute(task);
+                continue;
+            }
+            std::unique_lock<std::mutex> guard(sleep_lock);
+            wake.wait(guard, [this] { return stopping.load() || pending.load() > 0; });
+            if (stopping.load() && pending.load() == 0) {
+                return;
+            }
+        }
+    }
+
+   public:
+    /**
+     * @brief Cria o pool com a quantidade de threads dada. Com 0 threads, fork_join roda tudo na
+     * thread que chamou.
+     *
+     * @param threads quantidade de threads do pool, além das que chamam fork_join
+     */
+    explicit WorkPool(int threads) : queues(new Queue[(threads > 0 ? threads : 0) + 1]) {
+        int n = (threads > 0) ? threads : 0;
+        queue_count = n + 1;
+        workers.reserve(n);
+        for (int i = 0; i < n; i++) {
+            workers.emplace_back([this, i] { work(i); });
+        }
+    }
+
+    WorkPool(const WorkPool&) = delete;
+    WorkPool& operator=(const WorkPool&) = delete;
+
+    /**
+     * @brief Destrutor. Espera as threads terminarem as tarefas pendentes.
+     *
+     */
+    ~WorkPool() {
+        {
+            std::lock_guard<std::mutex> guard(sleep_lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : workers) {
+            t.join();
+        }
+    }
+
+    /**
+     * @brief Retorna o pool compartilhado pelas árvores: uma thread a menos que a quantidade de
+     * núcleos, já que a thread que chama fork_join também trabalha. É criado no primeiro uso.
+     *
+     * @return WorkPool&
+     */
+    static WorkPool& shared() {
+        static WorkPool pool(static_cast<int>(std::thread::hardware_concurrency()) - 1);
+        return pool;
+    }
+
+    /**
+     * @brief Retorna quantas threads podem trabalhar ao mesmo tempo: as do pool mais a que chama
+     *
+     * @return int
+     */
+    int concurrency() const {
+        return static_cast<int>(workers.size()) + 1;
+    }
+
+    /**
+     * @brief Executa f e g, possivelmente em paralelo, e só retorna quando as duas terminarem. f
+     * fica disponível para ser roubada por outra thread enquanto a atual executa g; se ninguém a
+     * roubou, a própria thread a executa em seguida. Enquanto espera uma f roubada, a thread
+     * executa outras tarefas em vez de bloquear. Exceções de f ou g são relançadas aqui.
+     *
+     * @param f Primeira tarefa
+     * @param g Segunda tarefa (roda na thread atual)
+     */
+    template <typename F, typename G>
+    void fork_join(F& f, G& g) {
+        if (workers.empty()) {
+            f();
+            g();
+            return;
+        }
+        int q = (_owner() == this) ? _index() : queue_count - 1;
+        Task task;
+        task.run = [](void* fn) { (*static_cast<F*>(fn))(); };
+        task.fn = &f;
+        push(q, &task);
+        std::exception_ptr error;
+        try {
+            g();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        if (take_back(q, &task)) {
+            execute(&task);
+        }
+        while (!task.done.load(std::memory_order_acquire)) {
+            Task* other = find(q);
+            if (other != nullptr) {
+                execute(other);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        if (task.error) {
+            std::rethrow_exception(task.error);
+        }
+    }
+};
+
+#endif  // WORKPOOL_H
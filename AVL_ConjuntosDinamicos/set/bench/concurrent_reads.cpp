@@ -0,0 +1,114 @@
+/**
+ * @file concurrent_reads.cpp
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief Medição de escala das leituras da Concurrent_AVL_Tree. Com um escritor inserindo e
+ * removendo o tempo todo, mede quantas buscas por segundo 1, 2, 4, ... threads leitoras fazem, e
+ * compara com uma AVL_Tree protegida por std::shared_mutex.
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread concurrent_reads.cpp -o concurrent_reads
+ * Executar: ./concurrent_reads [max_leitores] [milissegundos_por_medida]
+ *
+ * Em uma máquina com um núcleo as threads só se revezam, então os números não mostram escala.
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "../AVL.h"
+#include "../ConcurrentAVL.h"
+
+using namespace std;
+
+const int KEYS = 1000000;  // chaves pares sempre presentes; o escritor mexe nas ímpares
+
+/**
+ * @brief Roda readers leitoras e um escritor por ms milissegundos e retorna as buscas por segundo
+ *
+ * @param readers quantidade de threads leitoras
+ * @param ms duração da medida
+ * @param lookup busca feita pelas leitoras
+ * @param churn alteração feita pelo escritor
+ * @return double buscas por segundo, somando todas as leitoras
+ */
+template <typename Lookup, typename Churn>
+double measure(int readers, int ms, Lookup lookup, Churn churn) {
+    atomic<bool> stop{false};
+    atomic<long> total{0};
+    vector<thread> threads;
+    for (int r = 0; r < readers; r++) {
+        threads.emplace_back([&, r] {
+            mt19937 rng(r + 1);
+            long n = 0;
+            long found = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                found += lookup(static_cast<int>(rng() % KEYS) * 2);
+                n++;
+            }
+            if (found != n) {
+                fprintf(stderr, "chave par ausente\n");
+                exit(1);
+            }
+            total += n;
+        });
+    }
+    thread writer([&] {
+        mt19937 rng(0);
+        for (int i = 0; !stop.load(memory_order_relaxed); i++) {
+            churn(static_cast<int>(rng() % KEYS) * 2 + 1, i % 2 == 0);
+        }
+    });
+    this_thread::sleep_for(chrono::milliseconds(ms));
+    stop = true;
+    writer.join();
+    for (thread& t : threads) {
+        t.join();
+    }
+    return total.load() / (ms / 1000.0);
+}
+
+int main(int argc, char** argv) {
+    int max_readers = (argc > 1) ? atoi(argv[1]) : 2 * static_cast<int>(thread::hardware_concurrency());
+    int ms = (argc > 2) ? atoi(argv[2]) : 1000;
+    if (max_readers < 1) {
+        max_readers = 1;
+    }
+
+    Concurrent_AVL_Tree<int> lock_free;
+    AVL_Tree<int> locked;
+    shared_mutex lock;
+    for (int i = 0; i < KEYS; i++) {
+        lock_free.add(2 * i);
+        locked.add(2 * i);
+    }
+
+    printf("nucleos: %u\n", thread::hardware_concurrency());
+    printf("%8s %18s %18s\n", "leitores", "sem trava (op/s)", "shared_mutex (op/s)");
+    for (int readers = 1; readers <= max_readers; readers *= 2) {
+        double a = measure(
+            readers, ms, [&](int key) { return lock_free.contains(key); },
+            [&](int key, bool insert) { insert ? lock_free.add(key) : lock_free.remove(key); });
+        double b = measure(
+            readers, ms,
+            [&](int key) {
+                shared_lock<shared_mutex> guard(lock);
+                return locked.contains(key);
+            },
+            [&](int key, bool insert) {
+                unique_lock<shared_mutex> guard(lock);
+                insert ? locked.add(key) : locked.remove(key);
+            });
+        printf("%8d %18.0f %18.0f\n", readers, a, b);
+    }
+    return 0;
+}
@@ -0,0 +1,245 @@
+/**
+ * @file iterative_vs_recursive.cpp
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief Medição de add, remove e contains da AVL_Tree (iterativos, com pilha de links e retrace
+ * que para no primeiro node cuja altura não mudou) contra a versão recursiva anterior, copiada
+ * abaixo como RecursiveAVL. As duas usam o mesmo NodePool, então a diferença vem só da descida e
+ * do rebalanceamento. Carga: 1M inserções aleatórias, 2M pares remove + add e 1M buscas, todas
+ * com chaves em [0, 2M).
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread iterative_vs_recursive.cpp -o iterative_vs_recursive
+ * Executar: ./iterative_vs_recursive [insercoes]
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "../AVL.h"
+#include "../NodePool.h"
+
+using namespace std;
+
+/**
+ * @brief Versão recursiva de add, remove e contains, como era antes de AVL_Tree ficar iterativa
+ *
+ */
+class RecursiveAVL {
+   private:
+    struct Node {
+        int data{};
+        Node* left{};
+        Node* right{};
+        int height{};
+
+        Node(int data) : data(data), height(1) {}
+    };
+
+    Node* root{};
+    NodePool<Node> pool{};
+
+    int height(Node* node) {
+        return (node != nullptr) ? node->height : 0;
+    }
+
+    int balance(Node* node) {
+        return height(node->right) - height(node->left);
+    }
+
+    Node* rightRotation(Node* p) {
+        Node* u = p->left;
+        p->left = u->right;
+        u->right = p;
+        p->height = 1 + std::max(height(p->left), height(p->right));
+        u->height = 1 + std::max(height(u->left), height(u->right));
+        return u;
+    }
+
+    Node* leftRotation(Node* p) {
+        Node* u = p->right;
+        p->right = u->left;
+        u->left = p;
+        p->height = 1 + std::max(height(p->left), height(p->right));
+        u->height = 1 + std::max(height(u->left), height(u->right));
+        return u;
+    }
+
+    Node* _add(Node* p, int data) {
+        if (p == nullptr) {
+            return pool.create(data);
+        }
+        if (data == p->data) {
+            return p;
+        }
+        if (data < p->data) {
+            p->left = _add(p->left, data);
+        } else {
+            p->right = _add(p->right, data);
+        }
+        p = fixup_node(p, data);
+        return p;
+    }
+
+    Node* fixup_node(Node* p, int data) {
+        p->height = 1 + std::max(height(p->left), height(p->right));
+        int bal = balance(p);
+        if (bal < -1 && data < p->left->data) {
+            return rightRotation(p);
+        } else if (bal < -1 && data > p->left->data) {
+            p->left = leftRotation(p->left);
+            return rightRotation(p);
+        } else if (bal > 1 && data > p->right->data) {
+            return leftRotation(p);
+        } else if (bal > 1 && data < p->right->data) {
+            p->right = rightRotation(p->right);
+            return leftRotation(p);
+        }
+        return p;
+    }
+
+    Node* _remove(Node* node, int data) {
+        if (node == nullptr) {
+            return nullptr;
+        }
+        if (data < node->data) {
+            node->left = _remove(node->left, data);
+        } else if (data > node->data) {
+            node->right = _remove(node->right, data);
+        } else if (node->right == nullptr) {
+            Node* temp = node->left;
+            pool.destroy(node);
+            return temp;
+        } else {
+            node->right = remove_sucessor(node, node->right);
+        }
+        node = fixup_deletion(node);
+        return node;
+    }
+
+    Node* remove_sucessor(Node* root, Node* node) {
+        if (node->left != nullptr) {
+            node->left = remove_sucessor(root, node->left);
+        } else {
+            Node* temp = node->right;
+            root->data = node->data;
+            pool.destroy(node);
+            return temp;
+        }
+        node = fixup_deletion(node);
+        return node;
+    }
+
+    Node* fixup_deletion(Node* node) {
+        node->height = 1 + std::max(height(node->left), height(node->right));
+        int bal = balance(node);
+        if (bal < -1 && balance(node->left) <= 0) {
+            return rightRotation(node);
+        } else if (bal < -1 && balance(node->left) > 0) {
+            node->left = leftRotation(node->left);
+            return rightRotation(node);
+        } else if (bal > 1 && balance(node->right) >= 0) {
+            return leftRotation(node);
+        } else if (bal > 1 && balance(node->right) < 0) {
+            node->right = rightRotation(node->right);
+            return leftRotation(node);
+        }
+        return node;
+    }
+
+    Node* _contains(Node* node, int data) {
+        if (node == nullptr) {
+            return nullptr;
+        }
+        if (data == node->data) {
+            return node;
+        }
+        if (data < node->data) {
+            return _contains(node->left, data);
+        }
+        return _contains(node->right, data);
+    }
+
+   public:
+    void add(int data) {
+        root = _add(root, data);
+    }
+
+    void remove(int data) {
+        root = _remove(root, data);
+    }
+
+    bool contains(int data) {
+        return _contains(root, data) != nullptr;
+    }
+};
+
+/**
+ * @brief Chaves da carga, iguais para as duas árvores
+ *
+ */
+struct Workload {
+    vector<int> inserts;     // inserções iniciais
+    vector<int> churn;       // pares (remove churn[2i], add churn[2i + 1])
+    vector<int> lookups;     // buscas
+};
+
+/**
+ * @brief Roda a carga em uma árvore e imprime o tempo de cada fase
+ *
+ * @return long quantidade de buscas que acharam a chave, para conferir as duas árvores
+ */
+template <typename Tree>
+long run(const char* name, const Workload& w) {
+    Tree tree;
+    auto t0 = chrono::steady_clock::now();
+    for (int key : w.inserts) {
+        tree.add(key);
+    }
+    auto t1 = chrono::steady_clock::now();
+    for (size_t i = 0; i + 1 < w.churn.size(); i += 2) {
+        tree.remove(w.churn[i]);
+        tree.add(w.churn[i + 1]);
+    }
+    auto t2 = chrono::steady_clock::now();
+    long found = 0;
+    for (int key : w.lookups) {
+        found += tree.contains(key);
+    }
+    auto t3 = chrono::steady_clock::now();
+    auto ms = [](auto a, auto b) { return chrono::duration<double, milli>(b - a).count(); };
+    printf("%-10s %10.0f %10.0f %10.0f %10.0f\n", name, ms(t0, t1), ms(t1, t2), ms(t2, t3), ms(t0, t3));
+    return found;
+}
+
+int main(int argc, char** argv) {
+    int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+    mt19937 rng(7);
+    Workload w;
+    auto key = [&] { return static_cast<int>(rng() % (2u * n)); };
+    for (int i = 0; i < n; i++) {
+        w.inserts.push_back(key());
+    }
+    for (int i = 0; i < 2 * n; i++) {
+        w.churn.push_back(key());
+        w.churn.push_back(key());
+    }
+    for (int i = 0; i < n; i++) {
+        w.lookups.push_back(key());
+    }
+
+    printf("%-10s %10s %10s %10s %10s\n", "arvore", "add (ms)", "churn (ms)", "busca (ms)", "total (ms)");
+    long a = run<RecursiveAVL>("recursiva", w);
+    long b = run<AVL_Tree<int>>("iterativa", w);
+    if (a != b) {
+        fprintf(stderr, "buscas diferentes: %ld vs %ld\n", a, b);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file parallel_workers.cpp
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief Verificação de quantas threads as operações em lote da AVL_Tree usam. Uma política de
+ * instrumentação anota a thread de cada comparação; para um lote grande, insert_batch,
+ * erase_batch, unite, intersect e subtract devem comparar em mais de uma e no máximo
+ * hardware_concurrency() threads (a que chamou e as do WorkPool). A quantidade de threads do
+ * processo também é mostrada antes e depois das operações: ela não muda, porque o pool é criado
+ * uma vez e as divisões viram tarefas, não threads novas.
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread parallel_workers.cpp -o parallel_workers
+ * Executar: ./parallel_workers
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "../AVL.h"
+
+using namespace std;
+
+const int BATCH = 1 << 20;
+
+atomic<int> generation{0};  // muda a cada medida
+atomic<size_t> workers{0};  // threads que compararam chaves na medida atual
+
+/**
+ * @brief Política de instrumentação que só conta quantas threads compararam chaves. A marca é
+ * thread_local, então uma thread nova conta mesmo que reaproveite o id de outra já encerrada.
+ *
+ */
+struct WorkerStats : NoStats {
+    void comparison() const {
+        static thread_local int seen = -1;
+        int now = generation.load(memory_order_relaxed);
+        if (seen != now) {
+            seen = now;
+            workers++;
+        }
+    }
+};
+
+using Tree = AVL_Tree<int, three_way, WorkerStats>;
+
+/**
+ * @brief Monta uma árvore com as chaves first, first + step, ... (count chaves)
+ *
+ */
+Tree make_tree(int first, int step, int count) {
+    vector<int> keys(count);
+    for (int i = 0; i < count; i++) {
+        keys[i] = first + i * step;
+    }
+    Tree t;
+    t.insert_batch(keys.begin(), keys.end());
+    return t;
+}
+
+/**
+ * @brief Retorna quantas threads o processo tem, lendo /proc/self/status (0 se não existir)
+ *
+ */
+int process_threads() {
+    ifstream status("/proc/self/status");
+    string field;
+    while (status >> field) {
+        if (field == "Threads:") {
+            int n = 0;
+            status >> n;
+            return n;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Roda op e confere se o número de threads que compararam chaves está em [2, limit] (ou é
+ * 1, em uma máquina de um núcleo)
+ *
+ * @return true se ficou dentro do limite
+ */
+bool check(const char* name, const function<void()>& op, size_t limit) {
+    generation++;
+    workers = 0;
+    auto start = chrono::steady_clock::now();
+    op();
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    size_t used = workers.load();
+    bool ok = (limit == 1) ? used == 1 : (used >= 2 && used <= limit);
+    printf("%-14s %3zu threads (limite %zu) %8.1f ms%s\n", name, used, limit, ms, ok ? "" : "  <-- ERRO");
+    return ok;
+}
+
+int main() {
+    unsigned hc = thread::hardware_concurrency();
+    size_t expected = (hc > 1) ? hc : 1;
+    bool ok = true;
+
+    Tree base = make_tree(0, 2, BATCH);  // o primeiro lote já cria o pool
+    int threads_before = process_threads();
+    vector<int> odds(BATCH);
+    for (int i = 0; i < BATCH; i++) {
+        odds[i] = 2 * i + 1;
+    }
+    ok &= check("insert_batch", [&] { base.insert_batch(odds.begin(), odds.end()); }, expected);
+    ok &= check("erase_batch", [&] { base.erase_batch(odds.begin(), odds.end()); }, expected);
+
+    Tree other = make_tree(1, 2, BATCH);
+    ok &= check("unite", [&] { base.unite(other); }, expected);
+    // todas as árvores cobrem [0, 2 * BATCH), senão um lado da divisão fica vazio e não compara
+    Tree thirds = make_tree(0, 3, 2 * BATCH / 3);
+    ok &= check("intersect", [&] { base.intersect(thirds); }, expected);
+    Tree sixths = make_tree(0, 6, 2 * BATCH / 6);
+    ok &= check("subtract", [&] { base.subtract(sixths); }, expected);
+
+    int threads_after = process_threads();
+    printf("threads do processo: %d antes, %d depois\n", threads_before, threads_after);
+    return ok ? 0 : 1;
+}
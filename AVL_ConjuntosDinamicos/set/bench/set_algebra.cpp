@@ -0,0 +1,116 @@
+/**
+ * @file set_algebra.cpp
+ * @author Júnior Silva (junior.silva@alu.ufc.br)
+ * @brief Medição de unionSets, intersectionSets e differenceSets da classe Set. Compara o percurso
+ * simultâneo em ordem (O(n + m), usado pela classe) com a versão que percorre um conjunto e insere
+ * ou busca chave por chave na árvore (O(n log m)). Os dois conjuntos recebem 1M inserções
+ * aleatórias em [0, 4M).
+ *
+ * Compilar: g++ -std=c++17 -O2 -pthread set_algebra.cpp -o set_algebra
+ * Executar: ./set_algebra [insercoes_por_conjunto]
+ * @version 0.1
+ * @date 07-05-2024
+ *
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "../Set.h"
+
+using namespace std;
+
+/**
+ * @brief União inserindo chave por chave
+ *
+ */
+Set union_per_key(const Set& a, const Set& b) {
+    Set result;
+    for (int key : a) {
+        result.insert(key);
+    }
+    for (int key : b) {
+        result.insert(key);
+    }
+    return result;
+}
+
+/**
+ * @brief Interseção buscando cada chave de a em b
+ *
+ */
+Set intersection_per_key(const Set& a, const Set& b) {
+    Set result;
+    for (int key : a) {
+        if (b.contains(key)) {
+            result.insert(key);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Diferença buscando cada chave de a em b
+ *
+ */
+Set difference_per_key(const Set& a, const Set& b) {
+    Set result;
+    for (int key : a) {
+        if (!b.contains(key)) {
+            result.insert(key);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Executa op e retorna o tempo em milissegundos; o tamanho do resultado vai para size
+ *
+ */
+template <typename Op>
+double time_ms(Op op, int& size) {
+    auto start = chrono::steady_clock::now();
+    Set result = op();
+    auto end = chrono::steady_clock::now();
+    size = result.size();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+int main(int argc, char** argv) {
+    int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+    mt19937 rng(42);
+    Set a, b;
+    for (int i = 0; i < n; i++) {
+        a.insert(static_cast<int>(rng() % (4u * n)));
+        b.insert(static_cast<int>(rng() % (4u * n)));
+    }
+    printf("|a| = %d, |b| = %d\n", a.size(), b.size());
+    printf("%-14s %14s %14s\n", "operacao", "por chave (ms)", "percurso (ms)");
+
+    int s1 = 0;
+    int s2 = 0;
+    bool ok = true;
+    double t1 = time_ms([&] { return union_per_key(a, b); }, s1);
+    double t2 = time_ms([&] { return a.unionSets(b); }, s2);
+    printf("%-14s %14.0f %14.0f\n", "uniao", t1, t2);
+    ok &= (s1 == s2);
+
+    t1 = time_ms([&] { return intersection_per_key(a, b); }, s1);
+    t2 = time_ms([&] { return a.intersectionSets(b); }, s2);
+    printf("%-14s %14.0f %14.0f\n", "intersecao", t1, t2);
+    ok &= (s1 == s2);
+
+    t1 = time_ms([&] { return difference_per_key(a, b); }, s1);
+    t2 = time_ms([&] { return a.differenceSets(b); }, s2);
+    printf("%-14s %14.0f %14.0f\n", "diferenca", t1, t2);
+    ok &= (s1 == s2);
+
+    if (!ok) {
+        fprintf(stderr, "resultados com tamanhos diferentes\n");
+        return 1;
+    }
+    return 0;
+}
@@ -32,6 +32,11 @@ Comandos:
 - pred <set_index> <element> : Retorna o antecessor de um elemento no conjunto.
 - empty <set_index> : Verifica se o conjunto está vazio.
 - size <set_index> : Retorna o número de elementos do conjunto.
+- rank <set_index> <element> : Retorna quantos elementos do conjunto são menores que o elemento.
+- select <set_index> <k> : Retorna o k-ésimo menor elemento do conjunto (k começa em 0).
+- range <set_index> <lo> <hi> : Retorna quantos elementos do conjunto estão em [lo, hi].
+- save <set_index> <arquivo> : Grava o conjunto em um snapshot binário.
+- load <set_index> <arquivo> : Substitui o conjunto pelo conteúdo de um snapshot binário.
 
 - uni <set_index1> <set_index2> : Cria um novo conjunto com a união dos elementos de dois conjuntos.
 - int <set_index1> <set_index2> : Cria um novo conjunto com a interseção dos elementos de dois conjuntos.
@@ -42,7 +47,7 @@ Comandos:
 */
 
 // Vector global que armazena os conjuntos
-vector<Set> sets(3, Set());
+vector<Set> sets(3);
 
 /**
  * @brief Função que verifica se um índice é válido. Se não for, imprime uma mensagem de erro.
@@ -188,6 +193,63 @@ int main() {
                 cout << sets[set_index].size() << endl;
         }
 
+        // *** RANK *** //
+        else if (cmd == "rank") {
+            int set_index, element;
+            iss >> set_index >> element;
+            if (checkIndex(set_index))
+                cout << sets[set_index].rank(element) << endl;
+        }
+
+        // *** SELECT *** //
+        else if (cmd == "select") {
+            int set_index, k;
+            iss >> set_index >> k;
+            if (checkIndex(set_index)) {
+                try {
+                    cout << sets[set_index].select(k) << endl;
+                } catch (const std::runtime_error &e) {
+                    cout << e.what() << endl;
+                }
+            }
+        }
+
+        // *** RANGE *** //
+        else if (cmd == "range") {
+            int set_index, lo, hi;
+            iss >> set_index >> lo >> hi;
+            if (checkIndex(set_index))
+                cout << sets[set_index].count_range(lo, hi) << endl;
+        }
+
+        // *** SAVE *** //
+        else if (cmd == "save") {
+            int set_index;
+            string path;
+            iss >> set_index >> path;
+            if (checkIndex(set_index)) {
+                try {
+                    sets[set_index].save(path);
+                } catch (const std::runtime_error &e) {
+                    cout << e.what() << endl;
+                }
+            }
+        }
+
+        // *** LOAD *** //
+        else if (cmd == "load") {
+            int set_index;
+            string path;
+            iss >> set_index >> path;
+            if (checkIndex(set_index)) {
+                try {
+                    sets[set_index] = Set::load(path);
+                } catch (const std::runtime_error &e) {
+                    cout << e.what() << endl;
+                }
+            }
+        }
+
         // *** UNION *** //
         else if (cmd == "uni") {
             int set_index1, set_index2;
@@ -234,7 +296,12 @@ int main() {
             cout << "- succ <set_index> <element> : Retorna o sucessor de um elemento no conjunto.\n";
             cout << "- pred <set_index> <element> : Retorna o antecessor de um elemento no conjunto.\n";
             cout << "- empty <set_index> : Verifica se o conjunto está vazio.\n";
-            cout << "- size <set_index> : Retorna o número de elementos do conjunto.\n\n";
+            cout << "- size <set_index> : Retorna o número de elementos do conjunto.\n";
+            cout << "- rank <set_index> <element> : Retorna quantos elementos do conjunto são menores que o elemento.\n";
+            cout << "- select <set_index> <k> : Retorna o k-ésimo menor elemento do conjunto (k começa em 0).\n";
+            cout << "- range <set_index> <lo> <hi> : Retorna quantos elementos do conjunto estão em [lo, hi].\n";
+            cout << "- save <set_index> <arquivo> : Grava o conjunto em um snapshot binário.\n";
+            cout << "- load <set_index> <arquivo> : Substitui o conjunto pelo conteúdo de um snapshot binário.\n\n";
             cout << "- uni <set_index1> <set_index2> : Imprime a união dos elementos de dois conjuntos.\n";
             cout << "- int <set_index1> <set_index2> : Imprime a interseção dos elementos de dois conjuntos.\n";
             cout << "- dif <set_index1> <set_index2> : Imprime a diferença dos elementos de dois conjuntos.\n\n";